@@ -0,0 +1,131 @@
+#ifndef ALIGNED_ALLOCATOR_H_
+#define ALIGNED_ALLOCATOR_H_
+
+#include <new>
+#include <atomic>
+#include <vector>
+#include <cstdlib>
+#include <cstddef>
+#include <algorithm>
+#include <sys/mman.h>
+
+constexpr size_t CACHE_LINE_SIZE    = 64;
+constexpr size_t HUGE_PAGE_SIZE     = 2 << 20;
+
+// global switch: allocations of at least one huge page are backed by transparent huge pages
+inline bool& use_huge_pages()
+{
+    static bool enabled = false;
+
+    return enabled;
+}
+
+// bytes requested through AlignedAllocator while counting is enabled, for all threads
+struct AllocationCounters
+{
+    std::atomic<bool>   enabled{false};
+    std::atomic<size_t> live{0};        // allocated and not yet freed
+    std::atomic<size_t> peak{0};        // maximum of live since the last reset_peak
+    std::atomic<size_t> total{0};       // sum of all allocations
+
+    void reset_peak()
+    {
+        peak = live.load();
+    };
+};
+
+inline AllocationCounters& allocation_counters()
+{
+    static AllocationCounters counters;
+
+    return counters;
+}
+
+// allocator returning memory aligned to Alignment bytes (a cache line by default)
+template <typename T, size_t Alignment = CACHE_LINE_SIZE>
+class AlignedAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(AlignedAllocator<U, Alignment> const&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        size_t  bytes       = n * sizeof(T);
+        size_t  alignment   = Alignment;
+        void*   p           = nullptr;
+
+        // large buffers are aligned to and padded up to whole huge pages, so that the
+        // kernel can back them by huge pages and the TLB covers them with few entries
+        if (use_huge_pages() and bytes >= HUGE_PAGE_SIZE)
+        {
+            alignment   = HUGE_PAGE_SIZE;
+            bytes       = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        }
+
+        if (posix_memalign(&p, alignment, bytes) != 0)
+            throw std::bad_alloc();
+
+#ifdef MADV_HUGEPAGE
+        // only a hint, if transparent huge pages are disabled the call fails harmlessly
+        if (alignment == HUGE_PAGE_SIZE)
+            madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+
+        AllocationCounters& counters = allocation_counters();
+
+        if (counters.enabled.load(std::memory_order_relaxed))
+        {
+            size_t live = counters.live += n * sizeof(T);
+            size_t peak = counters.peak.load();
+
+            counters.total += n * sizeof(T);
+            while (live > peak and not counters.peak.compare_exchange_weak(peak, live))
+                ;
+        }
+
+        return static_cast<T*>(p);
+    };
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        AllocationCounters& counters = allocation_counters();
+
+        // memory allocated before counting was enabled is not subtracted below zero
+        if (counters.enabled.load(std::memory_order_relaxed))
+        {
+            size_t live = counters.live.load();
+            while (not counters.live.compare_exchange_weak(live, live - std::min(live, n * sizeof(T))))
+                ;
+        }
+
+        free(p);
+    };
+};
+
+template <typename T, typename U, size_t Alignment>
+bool operator==(AlignedAllocator<T, Alignment> const&, AlignedAllocator<U, Alignment> const&) noexcept
+{
+    return true;
+}
+
+template <typename T, typename U, size_t Alignment>
+bool operator!=(AlignedAllocator<T, Alignment> const&, AlignedAllocator<U, Alignment> const&) noexcept
+{
+    return false;
+}
+
+// working storage of all transforms
+template <typename T>
+using FftBuffer = std::vector<T, AlignedAllocator<T>>;
+
+#endif
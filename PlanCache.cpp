@@ -0,0 +1,99 @@
+#include <chrono>
+
+#include "PlanCache.hpp"
+
+PlanCache& PlanCache::global()
+{
+    static PlanCache cache(4096, 3, 16);
+
+    return cache;
+}
+
+long PlanCache::now_us()
+{
+    using namespace std::chrono;
+
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void PlanCache::touch(Entry& entry)
+{
+    long now = now_us();
+
+    // skip the write for recently used entries, so that hot entries stay in shared cache state
+    if (now - entry.last_used.load(std::memory_order_relaxed) > 1000)
+        entry.last_used.store(now, std::memory_order_relaxed);
+}
+
+std::shared_ptr<FftPlan const> PlanCache::get(PlanKey const& key)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(m);
+
+        auto it = entries.find(key);
+
+        if (it != entries.end())
+        {
+            touch(*it->second);
+            hits.increment();
+            return it->second->plan;
+        }
+    }
+
+    // planning happens outside of the lock, concurrent misses of the same key may both plan
+    auto plan = std::make_shared<FftPlan const>(make_plan(key.size, radix_option, radix_threshold, key.direction, key.stride, key.distance));
+
+    std::unique_lock<std::shared_mutex> lock(m);
+
+    auto it = entries.find(key);
+
+    if (it != entries.end())
+    {
+        touch(*it->second);
+        hits.increment();
+        return it->second->plan;
+    }
+
+    misses.fetch_add(1, std::memory_order_relaxed);
+
+    // evict least recently used plans, plans in use stay alive through their shared pointers;
+    // an entry at the back that was used since it was placed gets a second chance at the front,
+    // every move follows a hit, so an eviction costs amortized O(1)
+    while (not lru.empty() and entries.size() >= entry_cap)
+    {
+        auto    oldest  = entries.find(lru.back());
+        Entry&  entry   = *oldest->second;
+        long    used    = entry.last_used.load(std::memory_order_relaxed);
+
+        if (used != entry.listed)
+        {
+            entry.listed = used;
+            lru.splice(lru.begin(), lru, entry.position);
+            continue;
+        }
+
+        lru.pop_back();
+        entries.erase(oldest);
+        evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    lru.push_front(key);
+    entries.emplace(key, std::make_unique<Entry>(plan, now_us(), lru.begin()));
+
+    return plan;
+}
+
+PlanCacheStats PlanCache::stats() const
+{
+    std::shared_lock<std::shared_mutex> lock(m);
+
+    return PlanCacheStats{hits.load(), misses.load(), evictions.load(), entries.size()};
+}
+
+void PlanCache::clear()
+{
+    std::unique_lock<std::shared_mutex> lock(m);
+
+    entries.clear();
+    lru.clear();
+}
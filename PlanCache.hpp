@@ -0,0 +1,154 @@
+#ifndef PLAN_CACHE_H_
+#define PLAN_CACHE_H_
+
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstddef>
+#include <unordered_map>
+#include <shared_mutex>
+
+#include "ffts.hpp"
+
+// everything that distinguishes two plans of the cache, precision is the size of the real type in bytes
+struct PlanKey
+{
+    int size;
+    int precision;
+    int direction;
+    int stride;
+    int distance;
+
+    bool operator==(PlanKey const& other) const
+    {
+        return size == other.size and precision == other.precision and direction == other.direction
+               and stride == other.stride and distance == other.distance;
+    };
+};
+
+struct PlanKeyHash
+{
+    size_t operator()(PlanKey const& key) const
+    {
+        size_t h = 0;
+        for (int value : {key.size, key.precision, key.direction, key.stride, key.distance})
+            h = h * 1000003u ^ std::hash<int>{}(value);
+        return h;
+    };
+};
+
+// counter incremented by many threads, spread over cache lines to avoid contention
+class ShardedCounter
+{
+public:
+    void increment()
+    {
+        static thread_local size_t shard = std::hash<std::thread::id>{}(std::this_thread::get_id()) % nshards;
+
+        shards[shard].value.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    long load() const
+    {
+        long sum = 0;
+        for (auto const& shard : shards)
+            sum += shard.value.load(std::memory_order_relaxed);
+        return sum;
+    };
+
+    void reset()
+    {
+        for (auto& shard : shards)
+            shard.value.store(0, std::memory_order_relaxed);
+    };
+
+private:
+    static constexpr size_t nshards = 64;
+
+    struct alignas(64) Shard
+    {
+        std::atomic<long> value{0};
+    };
+
+    Shard shards[nshards];
+};
+
+struct PlanCacheStats
+{
+    long    hits;
+    long    misses;
+    long    evictions;
+    size_t  entries;
+};
+
+// Process-wide cache of immutable plans that may be shared by any number of threads.
+// Lookups of cached plans only take a shared lock and write nothing shared except the
+// time of last use of the entry, which is refreshed at most once per millisecond. Misses
+// create the plan outside of any lock and insert it exclusively, evicting the least
+// recently used plans above the cap from the back of a recency list in O(1): entries used
+// since they were placed in the list are moved to its front when they reach the back,
+// instead of on every hit. The cap is a number of plans: a plan holds only its
+// radices (the twiddle factors are computed during the transform), so its memory is small
+// and about the same for all sizes.
+class PlanCache
+{
+public:
+    PlanCache(size_t max_entries, int option, int threshold) : entry_cap{max_entries}, radix_option{option}, radix_threshold{threshold} {};
+
+    PlanCache(PlanCache const&) = delete;
+    PlanCache& operator=(PlanCache const&) = delete;
+
+    // the cache used by fft_cached, factors grouped up to radix 16, at most 4096 plans
+    static PlanCache& global();
+
+    std::shared_ptr<FftPlan const> get(PlanKey const& key);
+
+    PlanCacheStats stats() const;
+
+    // radix generation of the cached plans
+    int option() const { return radix_option; };
+    int threshold() const { return radix_threshold; };
+
+    void clear();
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<FftPlan const>  plan;
+        std::atomic<long>               last_used;
+        long                            listed;     // last_used when the entry was placed at the front of lru
+        std::list<PlanKey>::iterator    position;   // in lru
+
+        Entry(std::shared_ptr<FftPlan const> p, long t, std::list<PlanKey>::iterator i) : plan{std::move(p)}, last_used{t}, listed{t}, position{i} {};
+    };
+
+    size_t const                                                            entry_cap;
+    int const                                                               radix_option;
+    int const                                                               radix_threshold;
+    std::unordered_map<PlanKey, std::unique_ptr<Entry>, PlanKeyHash>        entries;
+    std::list<PlanKey>                                                      lru;        // most recently placed first
+    mutable std::shared_mutex                                               m;
+    ShardedCounter                                                          hits;
+    std::atomic<long>                                                       misses{0};
+    std::atomic<long>                                                       evictions{0};
+
+    static long now_us();
+
+    static void touch(Entry& entry);
+};
+
+// transform howmany blocks at data with a cached plan, every thread has its own workspace
+template <typename complex_t>
+void fft_cached(complex_t* data, int size, int direction, int howmany = 1, int stride = 1, int distance = 0)
+{
+    static thread_local FftBuffer<complex_t> work;
+
+    PlanKey                         key{size, static_cast<int>(sizeof(typename complex_t::value_type)), direction, stride, distance == 0 ? size : distance};
+    std::shared_ptr<FftPlan const>  plan = PlanCache::global().get(key);
+
+    execute_batch(*plan, data, howmany, work);
+}
+
+#endif
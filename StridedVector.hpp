@@ -1,13 +1,16 @@
 #include <vector>
+#include <cassert>
 #include <iostream>
 
+#include "AlignedAllocator.hpp"
+
 
 // class for strided access with an offset of the underlying vector
 template <typename T>
 class StridedVector
 {
 private:
-    std::vector<T>& v;
+    FftBuffer<T>& v;
     int const stride;
     int const offset;
     size_t const strided_size;
@@ -31,8 +34,8 @@ public:
         return strided_size;
     };
 
-    explicit StridedVector(std::vector<T>& v) : v{v}, stride{1}, offset{0}, strided_size{v.size()} {};
-    explicit StridedVector(std::vector<T>& v, int const stride, int const offset, int const size) : v{v}, stride{stride}, offset{offset}, strided_size(size)
+    explicit StridedVector(FftBuffer<T>& v) : v{v}, stride{1}, offset{0}, strided_size{v.size()} {};
+    explicit StridedVector(FftBuffer<T>& v, int const stride, int const offset, int const size) : v{v}, stride{stride}, offset{offset}, strided_size(size)
     {
         assert(0 <= offset and offset < v.size() and stride > 0);
     };
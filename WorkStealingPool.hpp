@@ -0,0 +1,320 @@
+#ifndef WORK_STEALING_POOL_H_
+#define WORK_STEALING_POOL_H_
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cassert>
+#include <functional>
+#include <condition_variable>
+
+#include "numa.hpp"
+
+// unit of work of the pool, pending is the counter of the task group it belongs to,
+// the completion of a root task is signalled to the thread waiting in WorkStealingPool::run
+struct Task
+{
+    std::function<void()>   fn;
+    std::atomic<int>*       pending;
+    bool                    is_root = false;
+};
+
+// Lock-free work-stealing deque (Chase and Lev, with the memory orders of Le et al.)
+// of fixed capacity. The owner pushes and pops at the bottom, thieves steal at the top.
+class TaskDeque
+{
+public:
+    static constexpr long capacity = 1 << 12;
+
+    TaskDeque() : top{0}, bottom{0}, tasks(capacity) {};
+
+    // returns false if the deque is full, the owner then runs the task itself
+    bool push(Task* task)
+    {
+        long b = bottom.load(std::memory_order_relaxed);
+        long t = top.load(std::memory_order_acquire);
+
+        if (b - t >= capacity)
+            return false;
+
+        tasks[b & (capacity - 1)].store(task, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_release);
+
+        return true;
+    };
+
+    Task* pop()
+    {
+        long b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long t = top.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Task* task = tasks[b & (capacity - 1)].load(std::memory_order_relaxed);
+
+        // last task: race against the thieves
+        if (t == b)
+        {
+            if (not top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                task = nullptr;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        return task;
+    };
+
+    Task* steal()
+    {
+        long t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long b = bottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+            return nullptr;
+
+        Task* task = tasks[t & (capacity - 1)].load(std::memory_order_relaxed);
+
+        if (not top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+
+        return task;
+    };
+
+private:
+    alignas(64) std::atomic<long>       top;
+    alignas(64) std::atomic<long>       bottom;
+    std::vector<std::atomic<Task*>>     tasks;
+};
+
+// Fork-join runtime with one deque per worker thread. Tasks spawned by a worker go to
+// its own deque, idle workers steal from the others. Threads waiting for a task group
+// keep executing tasks, so nested parallelism does not block workers.
+class WorkStealingPool
+{
+public:
+    explicit WorkStealingPool(int nthreads, bool pin_threads = false) : deques(nthreads), stop{false}, active_runs{0}
+    {
+        assert( nthreads > 0 );
+
+        std::vector<WorkerPlacement> placement = place_workers(read_numa_topology(), nthreads);
+
+        for (int w = 0; w < nthreads; ++w)
+            threads.emplace_back([this, w, pin_threads, cpu = placement[w].cpu] {
+                if (pin_threads)
+                    pin_current_thread(cpu);
+                worker_loop(w);
+            });
+    };
+
+    ~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stop = true;
+        }
+        cv.notify_all();
+
+        for (auto& thread : threads)
+            thread.join();
+    };
+
+    WorkStealingPool(WorkStealingPool const&) = delete;
+    WorkStealingPool& operator=(WorkStealingPool const&) = delete;
+
+    int size() const
+    {
+        return static_cast<int>(deques.size());
+    };
+
+    // run fn as root task on the workers and wait for it
+    void run(std::function<void()> fn)
+    {
+        std::atomic<int>    pending{1};
+        Task                root{std::move(fn), &pending, true};
+
+        std::unique_lock<std::mutex> lock(m);
+        injected.push_back(&root);
+        ++active_runs;
+        cv.notify_all();
+
+        done_cv.wait(lock, [&]{ return pending.load(std::memory_order_acquire) == 0; });
+        --active_runs;
+    };
+
+    // push a task to the deque of the calling worker, if the deque is full run it right away
+    void spawn(Task* task)
+    {
+        assert( current_pool() == this );
+
+        if (not deques[current_worker()].push(task))
+            execute(task);
+    };
+
+    // execute one available task of the calling worker, returns false if none was found
+    bool execute_one()
+    {
+        assert( current_pool() == this );
+
+        Task* task = find_task(current_worker());
+
+        if (task == nullptr)
+            return false;
+
+        execute(task);
+
+        return true;
+    };
+
+private:
+    std::vector<TaskDeque>      deques;
+    std::vector<std::thread>    threads;
+    std::deque<Task*>           injected;
+    bool                        stop;
+    int                         active_runs;
+    std::mutex                  m;
+    std::condition_variable     cv;
+    std::condition_variable     done_cv;
+
+    static WorkStealingPool*& current_pool()
+    {
+        static thread_local WorkStealingPool* pool = nullptr;
+        return pool;
+    };
+
+    static int& current_worker()
+    {
+        static thread_local int worker = 0;
+        return worker;
+    };
+
+    void execute(Task* task)
+    {
+        // the decrement is the last access, afterwards the task group may release the task
+        std::atomic<int>*   pending = task->pending;
+        bool                is_root = task->is_root;
+
+        task->fn();
+
+        pending->fetch_sub(1, std::memory_order_release);
+
+        if (is_root)
+        {
+            std::lock_guard<std::mutex> lock(m);
+            done_cv.notify_all();
+        }
+    };
+
+    Task* find_task(int w)
+    {
+        if (Task* task = deques[w].pop())
+            return task;
+
+        // steal from the other workers starting with the next one
+        int n = size();
+        for (int i = 1; i < n; ++i)
+            if (Task* task = deques[(w + i) % n].steal())
+                return task;
+
+        std::lock_guard<std::mutex> lock(m);
+
+        if (injected.empty())
+            return nullptr;
+
+        Task* task = injected.front();
+        injected.pop_front();
+
+        return task;
+    };
+
+    void worker_loop(int w)
+    {
+        current_pool()      = this;
+        current_worker()    = w;
+
+        for (;;)
+        {
+            if (Task* task = find_task(w))
+            {
+                execute(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m);
+
+            if (stop)
+                return;
+
+            // park while no computation is running, otherwise keep looking for work
+            if (active_runs == 0)
+                cv.wait(lock, [&]{ return stop or active_runs > 0; });
+            else
+            {
+                lock.unlock();
+                std::this_thread::yield();
+            }
+        }
+    };
+};
+
+// Group of tasks spawned by one parent, wait returns once all of them have finished.
+// While waiting the thread executes other tasks, starting with its own children.
+class TaskGroup
+{
+public:
+    explicit TaskGroup(WorkStealingPool& worker_pool) : pool{worker_pool}, pending{0} {};
+
+    ~TaskGroup()
+    {
+        wait();
+    };
+
+    template <typename F>
+    void spawn(F&& fn)
+    {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        tasks.push_back(Task{std::forward<F>(fn), &pending, false});
+        pool.spawn(&tasks.back());
+    }
+
+    void wait()
+    {
+        while (pending.load(std::memory_order_acquire) > 0)
+            if (not pool.execute_one())
+                std::this_thread::yield();
+    };
+
+private:
+    WorkStealingPool&   pool;
+    std::atomic<int>    pending;
+    std::deque<Task>    tasks;
+};
+
+// split [begin, end) into chunks of at most grain indices executed as tasks, body(first, last)
+template <typename Body>
+void parallel_for(WorkStealingPool& pool, int begin, int end, int grain, Body const& body)
+{
+    if (end - begin <= grain)
+    {
+        body(begin, end);
+        return;
+    }
+
+    // recursive halving keeps the deques short and lets thieves take large pieces
+    int middle = begin + (end - begin) / 2;
+
+    TaskGroup group(pool);
+    group.spawn([&]{ parallel_for(pool, begin, middle, grain, body); });
+    parallel_for(pool, middle, end, grain, body);
+    group.wait();
+}
+
+#endif
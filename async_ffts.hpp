@@ -0,0 +1,207 @@
+#ifndef ASYNC_FFTS_H_
+#define ASYNC_FFTS_H_
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cassert>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+
+#include "ffts.hpp"
+#include "PlanCache.hpp"
+
+struct FftExecutorStats
+{
+    long    requests;
+    long    transforms;
+    long    batches;
+};
+
+// Dedicated threads that transform buffers of other threads asynchronously, in place, with plans
+// from a plan cache. Requests of the same size and direction that are pending when a thread becomes
+// free are coalesced into one batch of at most max_batch transforms, so that under load the fixed costs
+// of a request (wake-up, plan lookup, workspace) are paid once per batch. Sizes are served in the order
+// of their oldest pending request, so a busy size does not starve the others. The buffer of a request must
+// stay valid until its future is ready or its callback has been called. Completion callbacks run on the
+// executor threads and must not block, they are meant to resume coroutines or to signal other threads.
+template <typename complex_t>
+class FftExecutor
+{
+public:
+    using Callback = std::function<void(std::exception_ptr)>;
+
+    explicit FftExecutor(int nthreads, int batch_limit = 64, PlanCache& plan_cache = PlanCache::global())
+        : max_batch{batch_limit}, cache{plan_cache}, stop{false}
+    {
+        assert( nthreads > 0 and batch_limit > 0 );
+
+        for (int t = 0; t < nthreads; ++t)
+            threads.emplace_back([this] { run(); });
+    };
+
+    FftExecutor(FftExecutor const&) = delete;
+    FftExecutor& operator=(FftExecutor const&) = delete;
+
+    // pending requests are completed before the threads end
+    ~FftExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stop = true;
+        }
+        cv.notify_all();
+
+        for (auto& thread : threads)
+            thread.join();
+    };
+
+    // transform howmany contiguous blocks of size elements at data, done(nullptr) or done(exception) is called once
+    void submit(complex_t* data, int size, int direction, int howmany, Callback done)
+    {
+        assert( data != nullptr and size > 0 and howmany > 0 );
+        assert( direction == FFT_FORWARD or direction == FFT_BACKWARD );
+
+        PlanKey key{size, static_cast<int>(sizeof(typename complex_t::value_type)), direction, 1, size};
+
+        {
+            std::lock_guard<std::mutex> lock(m);
+
+            auto& queue = pending[key];
+            if (queue.empty())
+                order.push_back(key);
+            queue.push_back(Request{data, howmany, next_sequence++, std::move(done)});
+        }
+        cv.notify_one();
+    };
+
+    std::future<void> submit(complex_t* data, int size, int direction, int howmany = 1)
+    {
+        auto                promise = std::make_shared<std::promise<void>>();
+        std::future<void>   result  = promise->get_future();
+
+        submit(data, size, direction, howmany, [promise](std::exception_ptr e) {
+            if (e)
+                promise->set_exception(e);
+            else
+                promise->set_value();
+        });
+
+        return result;
+    };
+
+    FftExecutorStats stats() const
+    {
+        return FftExecutorStats{requests.load(), transforms.load(), batches.load()};
+    };
+
+private:
+    struct Request
+    {
+        complex_t*  data;
+        int         howmany;
+        long        sequence;   // order of submission
+        Callback    done;
+    };
+
+    int const                                                               max_batch;
+    PlanCache&                                                              cache;
+    std::mutex                                                              m;
+    std::condition_variable                                                 cv;
+    std::deque<PlanKey>                                                     order;      // keys in the order of their oldest request
+    std::unordered_map<PlanKey, std::deque<Request>, PlanKeyHash>           pending;
+    long                                                                    next_sequence = 0;
+    bool                                                                    stop;
+    std::vector<std::thread>                                                threads;
+    std::atomic<long>                                                       requests{0};
+    std::atomic<long>                                                       transforms{0};
+    std::atomic<long>                                                       batches{0};
+
+    void run()
+    {
+        FftBuffer<complex_t>    work;
+        std::vector<Request>    batch;
+        std::vector<complex_t*> blocks;
+
+        for (;;)
+        {
+            PlanKey key{};
+
+            {
+                std::unique_lock<std::mutex> lock(m);
+
+                cv.wait(lock, [this] { return stop or not order.empty(); });
+
+                if (order.empty())
+                    return;
+
+                // the oldest requests of the longest waiting key, a request is never split
+                key = order.front();
+                order.pop_front();
+
+                auto&   queue = pending[key];
+                int     count = 0;
+
+                while (not queue.empty() and (batch.empty() or count + queue.front().howmany <= max_batch))
+                {
+                    count += queue.front().howmany;
+                    batch.push_back(std::move(queue.front()));
+                    queue.pop_front();
+                }
+
+                if (queue.empty())
+                    pending.erase(key);
+                else
+                {
+                    // the key is queued again by the age of its oldest remaining request, behind older requests of other keys
+                    long oldest = queue.front().sequence;
+                    auto later  = std::find_if(order.begin(), order.end(),
+                            [&](PlanKey const& other) { return pending.find(other)->second.front().sequence > oldest; });
+
+                    order.insert(later, key);
+                    cv.notify_one();
+                }
+            }
+
+            blocks.clear();
+            for (auto const& request : batch)
+                for (int b = 0; b < request.howmany; ++b)
+                    blocks.push_back(request.data + static_cast<ptrdiff_t>(b) * key.size);
+
+            std::exception_ptr error;
+
+            try
+            {
+                std::shared_ptr<FftPlan const> plan = cache.get(key);
+
+                // the first pass reads a whole block before the bins are stored, so the blocks are transformed in place
+                execute_batch_fused(*plan, static_cast<int>(blocks.size()),
+                        [&](int b, int n) { return blocks[b][n]; },
+                        [&](int b, int k, complex_t const& y) { blocks[b][k] = y; },
+                        work);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            requests    += static_cast<long>(batch.size());
+            transforms  += static_cast<long>(blocks.size());
+            ++batches;
+
+            for (auto& request : batch)
+                request.done(error);
+
+            batch.clear();
+        }
+    };
+};
+
+#endif
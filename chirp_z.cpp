@@ -0,0 +1,45 @@
+#include <cmath>
+#include <cassert>
+
+#include "chirp_z.hpp"
+#include "fast_sizes.hpp"
+
+ChirpZPlan make_chirp_z_plan(int size, int nbins, long double start, long double step, int option, int threshold)
+{
+    assert( size > 0 and nbins > 0 );
+
+    int conv_size = next_fast_size(size + nbins - 1, option, threshold);
+
+    ChirpZPlan plan{size, nbins, conv_size, make_plan(conv_size, option, threshold), {}, {}, {}};
+
+    // exp(-2 pi i phase) with the phase in cycles reduced to [0, 1) before the multiplication by 2 pi
+    auto cycles = [](long double phase) {
+        return static_cast<std::complex<double>>(std::polar(1.0L, -2 * PI * (phase - std::floor(phase))));
+    };
+
+    for (int n = 0; n < size; ++n)
+        plan.pre.push_back(cycles(start * n + step * n * static_cast<long double>(n) / 2));
+
+    for (int k = 0; k < nbins; ++k)
+        plan.post.push_back(cycles(step * k * static_cast<long double>(k) / 2));
+
+    // chirp exp(pi i step m^2) for -size < m < nbins, negative m wrap around
+    FftBuffer<std::complex<double>> chirp(conv_size, 0.0);
+
+    for (int m = 0; m < nbins; ++m)
+        chirp[m] = std::conj(plan.post[m]);
+    for (int m = 1; m < size; ++m)
+        chirp[conv_size - m] = std::conj(cycles(step * m * static_cast<long double>(m) / 2));
+
+    fft_iterative_breadth_first(chirp, plan.conv_plan.radices);
+
+    for (auto const& h : chirp)
+        plan.kernel.push_back(h / static_cast<double>(conv_size));
+
+    return plan;
+}
+
+ChirpZPlan make_bluestein_plan(int size, int option, int threshold)
+{
+    return make_chirp_z_plan(size, size, 0.0L, 1.0L / size, option, threshold);
+}
@@ -0,0 +1,51 @@
+#ifndef CHIRP_Z_H_
+#define CHIRP_Z_H_
+
+#include <vector>
+#include <complex>
+#include <cassert>
+
+#include "ffts.hpp"
+
+// Setup of the chirp-z transform X[k] = sum_n x[n] exp(-2 pi i n (start + k step)), 0 <= k < nbins,
+// of size inputs at frequencies in cycles per sample. With n k = (n^2 + k^2 - (k - n)^2) / 2 (Bluestein)
+// it is a convolution of x[n] exp(-2 pi i (start n + step n^2 / 2)) with the chirp exp(pi i step m^2),
+// computed by transforms of a fast length of at least size + nbins - 1.
+struct ChirpZPlan
+{
+    int                                 size;
+    int                                 nbins;
+    int                                 conv_size;
+    FftPlan                             conv_plan;
+    std::vector<std::complex<double>>   pre;        // exp(-2 pi i (start n + step n^2 / 2))
+    std::vector<std::complex<double>>   post;       // exp(-pi i step k^2)
+    std::vector<std::complex<double>>   kernel;     // transform of the chirp divided by conv_size
+};
+
+ChirpZPlan make_chirp_z_plan(int size, int nbins, long double start, long double step, int option, int threshold);
+
+// the DFT of any size, in particular of sizes with large prime factors
+ChirpZPlan make_bluestein_plan(int size, int option, int threshold);
+
+// out holds plan.nbins elements, the work vector is resized if necessary
+template <typename complex_t>
+void execute_chirp_z(ChirpZPlan const& plan, complex_t const* in, complex_t* out, FftBuffer<complex_t>& work)
+{
+    work.assign(plan.conv_size, 0.0);
+
+    for (int n = 0; n < plan.size; ++n)
+        work[n] = in[n] * static_cast<complex_t>(plan.pre[n]);
+
+    fft_iterative_breadth_first(work, plan.conv_plan.radices);
+
+    // the inverse transform of the product is the conjugate of the transform of the conjugate
+    for (int j = 0; j < plan.conv_size; ++j)
+        work[j] = std::conj(work[j] * static_cast<complex_t>(plan.kernel[j]));
+
+    fft_iterative_breadth_first(work, plan.conv_plan.radices);
+
+    for (int k = 0; k < plan.nbins; ++k)
+        out[k] = std::conj(work[k]) * static_cast<complex_t>(plan.post[k]);
+}
+
+#endif
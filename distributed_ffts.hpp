@@ -0,0 +1,129 @@
+#ifndef DISTRIBUTED_FFTS_H_
+#define DISTRIBUTED_FFTS_H_
+
+#include <vector>
+#include <complex>
+#include <cassert>
+#include <algorithm>
+
+#include "ffts.hpp"
+#include "parallel_ffts.hpp"
+#include "transport.hpp"
+
+// Global transpose of a slab-decomposed nrows x ncols matrix. Every rank holds
+// nrows / P consecutive rows of in and receives ncols / P consecutive rows of the
+// transposed matrix in out. Before its rows are sent, row_op(global_row, row) is
+// applied to them. The local rows are processed in nchunks chunks and the exchange
+// of a chunk is started as soon as it is ready, so with a transport that progresses
+// exchanges in the background (MpiTransport) communication overlaps with the
+// computation on the next chunk.
+template <typename complex_t, typename RowOp>
+void transform_and_transpose(Transport& transport, FftBuffer<complex_t>& in, int nrows, int ncols, FftBuffer<complex_t>& out, int nchunks, RowOp row_op)
+{
+    int const nranks        = transport.size();
+    int const rank          = transport.rank();
+    int const local_rows    = nrows / nranks;
+    int const local_cols    = ncols / nranks;
+
+    assert( nrows % nranks == 0 and ncols % nranks == 0 );
+    assert( static_cast<int>(in.size()) == local_rows * ncols );
+
+    nchunks = std::max(1, std::min(nchunks, local_rows));
+
+    std::vector<FftBuffer<complex_t>>   send(nchunks);
+    std::vector<FftBuffer<complex_t>>   recv(nchunks);
+    std::vector<int>                    requests;
+
+    for (int q = 0; q < nchunks; ++q)
+    {
+
+        int row_begin   = partition_begin(local_rows, q, nchunks);
+        int row_end     = partition_begin(local_rows, q + 1, nchunks);
+        int chunk_rows  = row_end - row_begin;
+
+        for (int i = row_begin; i < row_end; ++i)
+            row_op(rank * local_rows + i, in.data() + static_cast<size_t>(i) * ncols);
+
+        // block s holds the columns of rank s of all rows of the chunk
+        send[q] = FftBuffer<complex_t>(static_cast<size_t>(chunk_rows) * ncols);
+        recv[q] = FftBuffer<complex_t>(static_cast<size_t>(chunk_rows) * ncols);
+
+        for (int s = 0; s < nranks; ++s)
+            for (int i = row_begin; i < row_end; ++i)
+                std::copy_n(in.begin() + static_cast<long>(i) * ncols + static_cast<long>(s) * local_cols, local_cols,
+                            send[q].begin() + (static_cast<long>(s) * chunk_rows + (i - row_begin)) * local_cols);
+
+        requests.push_back(transport.start_alltoall(send[q].data(), recv[q].data(), static_cast<size_t>(chunk_rows) * local_cols * sizeof(complex_t)));
+
+    }
+
+    out.resize(static_cast<size_t>(local_cols) * nrows);
+
+    for (int q = 0; q < nchunks; ++q)
+    {
+
+        transport.wait(requests[q]);
+
+        int row_begin   = partition_begin(local_rows, q, nchunks);
+        int chunk_rows  = partition_begin(local_rows, q + 1, nchunks) - row_begin;
+
+        // block r holds rows r * local_rows + row_begin + i of the own columns
+        for (int r = 0; r < nranks; ++r)
+            for (int i = 0; i < chunk_rows; ++i)
+                for (int j = 0; j < local_cols; ++j)
+                    out[static_cast<size_t>(j) * nrows + r * local_rows + row_begin + i] = recv[q][(static_cast<size_t>(r) * chunk_rows + i) * local_cols + j];
+
+    }
+}
+
+// Distributed one-dimensional FFT of size n1 * n2 (see make_four_step_plan), both
+// n1 and n2 must be divisible by the number of ranks. Every rank holds the
+// contiguous part [rank * N / P, (rank + 1) * N / P) of the input in x and
+// receives the same part of the output in natural order.
+template <typename complex_t>
+void fft_distributed_1d(Transport& transport, FftBuffer<complex_t>& x, FourStepPlan& plan, int nchunks)
+{
+    int const   n1      = plan.n1;
+    int const   n2      = plan.n2;
+    long const  size    = static_cast<long>(n1) * n2;
+
+    FftBuffer<complex_t> columns;
+    FftBuffer<complex_t> rows;
+    FftBuffer<complex_t> work;
+
+    auto no_op          = [](int, complex_t*) {};
+    auto column_fft     = [&](int c, complex_t* column)
+    {
+        execute_batch(plan.plan1, column, 1, work);
+        for (int k1 = 0; k1 < n1; ++k1)
+            column[k1] *= static_cast<complex_t>(std::polar(1.0L, -2 * PI / size * (static_cast<long>(c) * k1 % size)));
+    };
+    auto row_fft        = [&](int, complex_t* row) { execute_batch(plan.plan2, row, 1, work); };
+
+    // x holds rows of the n1 x n2 matrix, afterwards columns holds rows of its transpose
+    transform_and_transpose(transport, x, n1, n2, columns, 1, no_op);
+    transform_and_transpose(transport, columns, n2, n1, rows, nchunks, column_fft);
+    // row k1 holds X[k1 + n1 * k2], the transpose is the output in natural order
+    transform_and_transpose(transport, rows, n1, n2, x, nchunks, row_fft);
+}
+
+// Distributed two-dimensional FFT of an nrows x ncols matrix in row-major format,
+// both dimensions must be divisible by the number of ranks. Every rank holds
+// nrows / P consecutive rows of the input in x and receives the same rows of the output.
+template <typename complex_t>
+void fft_distributed_2d(Transport& transport, FftBuffer<complex_t>& x, FftPlan& row_plan, FftPlan& column_plan, int nchunks)
+{
+    int const nrows = column_plan.size;
+    int const ncols = row_plan.size;
+
+    FftBuffer<complex_t> transposed;
+    FftBuffer<complex_t> work;
+
+    auto row_fft    = [&](int, complex_t* row) { execute_batch(row_plan, row, 1, work); };
+    auto column_fft = [&](int, complex_t* column) { execute_batch(column_plan, column, 1, work); };
+
+    transform_and_transpose(transport, x, nrows, ncols, transposed, nchunks, row_fft);
+    transform_and_transpose(transport, transposed, ncols, nrows, x, nchunks, column_fft);
+}
+
+#endif
@@ -0,0 +1,111 @@
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <cassert>
+#include <algorithm>
+
+#include "fast_sizes.hpp"
+
+double estimated_cost(int size, int option, int threshold, SizeCostModel const& model)
+{
+    double cost = 0.0;
+
+    for (int radix : compute_radices(size, option, threshold))
+        cost += model.stage_cost + model.radix_cost * radix;
+
+    return cost * size;
+}
+
+SizeCostModel measure_cost_model(int option, int threshold)
+{
+    using std::chrono::steady_clock;
+    using std::chrono::duration;
+
+    int const sizes[] = {1 << 14, 3 * 3 * 3 * 3 * 3 * 3 * 3 * 3, 5 * 5 * 5 * 5 * 5 * 5, 7 * 7 * 7 * 7 * 7, 17 * 17 * 17};
+
+    // least squares fit of time / size = stage_cost * stages + radix_cost * sum of radices
+    double s11 = 0.0, s12 = 0.0, s22 = 0.0, b1 = 0.0, b2 = 0.0;
+
+    for (int size : sizes)
+    {
+
+        std::vector<int>                    radices = compute_radices(size, option, threshold);
+        FftBuffer<std::complex<double>>     x(size, 1.0);
+        double                              best    = std::numeric_limits<double>::max();
+
+        for (int r = 0; r < 3; ++r)
+        {
+            auto start = steady_clock::now();
+            fft_iterative_breadth_first(x, radices);
+            best = std::min(best, duration<double, std::nano>(steady_clock::now() - start).count());
+        }
+
+        double stages   = static_cast<double>(radices.size());
+        double sum      = std::accumulate(radices.begin(), radices.end(), 0.0);
+        double t        = best / size;
+
+        s11 += stages * stages;
+        s12 += stages * sum;
+        s22 += sum * sum;
+        b1  += stages * t;
+        b2  += sum * t;
+
+    }
+
+    double det = s11 * s22 - s12 * s12;
+
+    SizeCostModel model;
+    if (det > 0.0)
+    {
+        model.stage_cost = std::max(0.0, (b1 * s22 - b2 * s12) / det);
+        model.radix_cost = std::max(0.0, (b2 * s11 - b1 * s12) / det);
+    }
+
+    return model;
+}
+
+bool is_smooth(int size)
+{
+    assert( size > 0 );
+
+    for (int p : {2, 3, 5, 7})
+        while (size % p == 0)
+            size /= p;
+
+    return size == 1;
+}
+
+int next_fast_size(int min_size, int option, int threshold, SizeCostModel const& model)
+{
+    assert( min_size > 0 and min_size <= (1 << 30) );
+
+    // the next power of two bounds the candidates
+    long long upper = 1;
+    while (upper < min_size)
+        upper *= 2;
+
+    int     best_size = static_cast<int>(upper);
+    double  best_cost = estimated_cost(best_size, option, threshold, model);
+
+    for (long long p7 = 1; p7 <= upper; p7 *= 7)
+        for (long long p5 = p7; p5 <= upper; p5 *= 5)
+            for (long long p3 = p5; p3 <= upper; p3 *= 3)
+            {
+                // smallest multiple by a power of two that is large enough
+                long long n = p3;
+                while (n < min_size)
+                    n *= 2;
+
+                if (n >= upper)
+                    continue;
+
+                double cost = estimated_cost(static_cast<int>(n), option, threshold, model);
+                if (cost < best_cost)
+                {
+                    best_cost = cost;
+                    best_size = static_cast<int>(n);
+                }
+            }
+
+    return best_size;
+}
@@ -0,0 +1,32 @@
+#ifndef FAST_SIZES_H_
+#define FAST_SIZES_H_
+
+#include "ffts.hpp"
+
+// Run time model of the mixed-radix kernels: a stage of radix r costs
+// stage_cost + radix_cost * r nanoseconds per element, since every output of a
+// butterfly sums r inputs. The defaults are the rounded mean of seven fits of
+// measure_cost_model, as printed by `./testit -t 10` of `make fast` (double precision)
+// with -g 1 and with -g 3 -r 16 on one core of a Xeon server: stage_cost 56.8 ... 64.7,
+// radix_cost 4.6 ... 5.3. Only their ratio matters for next_fast_size, an extra stage
+// costs as much as about 12 more in the sum of the radices. Absolute times, e.g. to
+// compare a padded length with a chirp-z transform, should use a model measured on the
+// target machine.
+struct SizeCostModel
+{
+    double  stage_cost  = 60.0;
+    double  radix_cost  = 5.0;
+};
+
+// estimated run time of a transform of the given size in nanoseconds
+double estimated_cost(int size, int option, int threshold, SizeCostModel const& model = SizeCostModel{});
+
+// fit the model to timings of the kernels on this machine
+SizeCostModel measure_cost_model(int option, int threshold);
+
+bool is_smooth(int size);
+
+// the 2^a 3^b 5^c 7^d length not smaller than min_size with the least estimated cost
+int next_fast_size(int min_size, int option, int threshold, SizeCostModel const& model = SizeCostModel{});
+
+#endif
@@ -0,0 +1,310 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <complex>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <limits>
+#include <stdexcept>
+#include <exception>
+#include <getopt.h>
+
+#include "ffts.hpp"
+
+using namespace std;
+
+using sample_t = complex<float>;
+
+// read up to one block of samples, a partial block at the end of the file is zero-padded
+static int read_block(ifstream& input, FftBuffer<sample_t>& block)
+{
+    input.read(reinterpret_cast<char*>(block.data()), static_cast<streamsize>(block.size() * sizeof(sample_t)));
+
+    size_t count = static_cast<size_t>(input.gcount()) / sizeof(sample_t);
+
+    if (count > 0)
+        fill(block.begin() + static_cast<long>(count), block.end(), sample_t{0.0f, 0.0f});
+
+    return static_cast<int>(count);
+}
+
+static void write_block(ofstream& output, FftBuffer<sample_t> const& block)
+{
+    output.write(reinterpret_cast<char const*>(block.data()), static_cast<streamsize>(block.size() * sizeof(sample_t)));
+
+    if (not output)
+        throw runtime_error("writing output failed");
+}
+
+// strictly sequential read - transform - write loop as reference
+static long run_sequential(ifstream& input, ofstream& output, FftPlan& plan)
+{
+    FftBuffer<sample_t> block(plan.size);
+    FftBuffer<sample_t> work;
+    long                nblocks = 0;
+
+    while (read_block(input, block) > 0)
+    {
+
+        execute_batch(plan, block.data(), 1, work);
+        write_block(output, block);
+        ++nblocks;
+
+    }
+
+    return nblocks;
+}
+
+// Ring of preallocated buffers shared by one reader thread, several worker threads
+// and one writer thread. Block b always occupies slot b % nslots, so a slot can only
+// be refilled once the writer has written its previous block (back-pressure).
+class BlockRing
+{
+public:
+    enum class State {empty, filled, transforming, transformed};
+
+    BlockRing(int nslots, int block_size) : slots(nslots, FftBuffer<sample_t>(block_size)), states(nslots, State::empty) {};
+
+    FftBuffer<sample_t>& slot(long b)
+    {
+        return slots[index(b)];
+    };
+
+    // wait until the slot of block b can be refilled by the reader
+    void acquire_for_read(long b)
+    {
+        unique_lock<mutex> lock(m);
+        cv.wait(lock, [&]{ return states[index(b)] == State::empty; });
+    };
+
+    // the reader announces block b, or the end of the input with nblocks
+    void publish_read(long b, bool last)
+    {
+        {
+            lock_guard<mutex> lock(m);
+            if (last)
+                nblocks = b;
+            else
+                states[index(b)] = State::filled;
+        }
+        cv.notify_all();
+    };
+
+    // a worker claims the next filled block, returns -1 if all blocks are processed
+    long acquire_for_transform()
+    {
+        unique_lock<mutex> lock(m);
+        cv.wait(lock, [&]{ return (next_transform < nblocks and states[index(next_transform)] == State::filled) or next_transform == nblocks; });
+
+        if (next_transform == nblocks)
+            return -1;
+
+        states[index(next_transform)] = State::transforming;
+
+        return next_transform++;
+    };
+
+    void publish_transform(long b)
+    {
+        {
+            lock_guard<mutex> lock(m);
+            states[index(b)] = State::transformed;
+        }
+        cv.notify_all();
+    };
+
+    // the writer waits for block b in order, returns false if there is none
+    bool acquire_for_write(long b)
+    {
+        unique_lock<mutex> lock(m);
+        cv.wait(lock, [&]{ return (b < nblocks and states[index(b)] == State::transformed) or b == nblocks; });
+
+        return b < nblocks;
+    };
+
+    void release(long b)
+    {
+        {
+            lock_guard<mutex> lock(m);
+            states[index(b)] = State::empty;
+        }
+        cv.notify_all();
+    };
+
+private:
+    vector<FftBuffer<sample_t>>   slots;
+    vector<State>               states;
+    long                        nblocks         = numeric_limits<long>::max();
+    long                        next_transform  = 0;
+    mutex                       m;
+    condition_variable          cv;
+
+    size_t index(long b) const
+    {
+        return static_cast<size_t>(b % static_cast<long>(slots.size()));
+    };
+};
+
+// pipelined loop: reading, transforming and writing of different blocks overlap
+static long run_pipelined(ifstream& input, ofstream& output, FftPlan& plan, int nslots, int nworkers)
+{
+    BlockRing       ring(nslots, plan.size);
+    long            nwritten = 0;
+    exception_ptr   error;
+    mutex           error_mutex;
+
+    thread reader([&]{
+        long b = 0;
+        for (;; ++b)
+        {
+            ring.acquire_for_read(b);
+            if (read_block(input, ring.slot(b)) == 0)
+                break;
+            ring.publish_read(b, false);
+        }
+        ring.publish_read(b, true);
+    });
+
+    vector<thread> workers;
+    for (int w = 0; w < nworkers; ++w)
+    {
+        workers.emplace_back([&]{
+            FftBuffer<sample_t> work;
+            for (long b = ring.acquire_for_transform(); b >= 0; b = ring.acquire_for_transform())
+            {
+                execute_batch(plan, ring.slot(b).data(), 1, work);
+                ring.publish_transform(b);
+            }
+        });
+    }
+
+    thread writer([&]{
+        try
+        {
+            for (; ring.acquire_for_write(nwritten); ++nwritten)
+            {
+                write_block(output, ring.slot(nwritten));
+                ring.release(nwritten);
+            }
+        }
+        catch (...)
+        {
+            lock_guard<mutex> lock(error_mutex);
+            error = current_exception();
+            // keep draining the ring so that the other threads can terminate
+            for (; ring.acquire_for_write(nwritten); ++nwritten)
+                ring.release(nwritten);
+        }
+    });
+
+    reader.join();
+    for (auto& worker : workers)
+        worker.join();
+    writer.join();
+
+    if (error)
+        rethrow_exception(error);
+
+    return nwritten;
+}
+
+int main(int argc, char ** argv)
+{
+    constexpr char const* const options = "b:g:hn:qr:w:";
+    constexpr char const* const usage = " [options] input output\n" \
+        " Transforms consecutive blocks of interleaved single precision IQ samples.\n" \
+        " -n n         Block size (1024)\n" \
+        " -g n         Choose algorithm for radix generation: 1 = factors, 2 = factors reversed, 3 = thresholded (1)\n" \
+        " -r n         Threshold for radix generation (32)\n" \
+        " -b n         Number of buffers in the ring (8)\n" \
+        " -w n         Number of worker threads (2)\n" \
+        " -q           Sequential processing without pipelining\n" \
+        " -h           Show this help\n" \
+        "\n";
+
+    using std::chrono::high_resolution_clock;
+    using std::chrono::duration;
+
+    try
+    {
+        int     block_size      = 1024;
+        int     algo_radix      = 1;
+        int     radix_threshold = 32;
+        int     nslots          = 8;
+        int     nworkers        = 2;
+        bool    sequential      = false;
+        int     c;
+
+        while((c = getopt(argc, argv, options)) != -1)
+        {
+            switch(c)
+            {
+            case 'n' :
+                block_size = stoi(optarg);
+                break;
+            case 'g' :
+                algo_radix = stoi(optarg);
+                break;
+            case 'r' :
+                radix_threshold = stoi(optarg);
+                break;
+            case 'b' :
+                nslots = stoi(optarg);
+                break;
+            case 'w' :
+                nworkers = stoi(optarg);
+                break;
+            case 'q' :
+                sequential = true;
+                break;
+            case 'h' :
+                cout << "usage: " << argv[0] << usage;
+                return 0;
+            case '?' :
+            default :
+                cerr << "usage: " << argv[0] << usage;
+                return -1;
+            }
+        }
+        if (argc - optind != 2 or block_size < 1 or algo_radix < 1 or algo_radix > 3 or radix_threshold < 2 or nslots < 1 or nworkers < 1)
+        {
+            cerr << "usage: " << argv[0] << usage;
+            return -2;
+        }
+
+        ifstream input(argv[optind], ios::binary);
+        ofstream output(argv[optind + 1], ios::binary);
+
+        if (not input or not output)
+        {
+            cerr << argv[0] << ": cannot open " << (input ? argv[optind + 1] : argv[optind]) << endl;
+            return -3;
+        }
+
+        FftPlan plan    = make_plan(block_size, algo_radix, radix_threshold);
+        auto start_time = high_resolution_clock::now();
+
+        long nblocks = sequential ? run_sequential(input, output, plan) : run_pipelined(input, output, plan, nslots, nworkers);
+
+        output.flush();
+        duration<double, std::milli> duration_ms = high_resolution_clock::now() - start_time;
+
+        double megabytes = static_cast<double>(nblocks) * block_size * sizeof(sample_t) / 1.0e6;
+
+        cout << "  blocks   size   time (ms)   throughput (MB/s)" << endl;
+        cout << setw(8) << nblocks
+             << setw(7) << block_size
+             << setw(12) << setprecision(2) << fixed << duration_ms.count()
+             << setw(20) << setprecision(2) << fixed << megabytes / (duration_ms.count() / 1000.0)
+             << endl;
+    }
+    catch(exception const& e)
+    {
+        cerr << argv[0] << ": Exception " << e.what() << " -- aborting\n";
+        return -4;
+    }
+}
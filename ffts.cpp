@@ -1,10 +1,56 @@
+#include <mutex>
+#include <memory>
 #include <vector>
+#include <cstdint>
 #include <algorithm>
 #include <numeric>
+#include <iterator>
 #include <cassert>
+#include <unordered_map>
 
 #include "ffts.hpp"
 
+namespace
+{
+
+// smallest prime factor of every n <= bound, 0 for primes, the factors of composites are below 2^16
+using FactorSieve = std::vector<std::uint16_t>;
+
+std::shared_ptr<FactorSieve const> make_factor_sieve(int bound)
+{
+    assert( bound > 0 );
+
+    auto sieve = std::make_shared<FactorSieve>(static_cast<size_t>(bound) + 1, 0);
+
+    for (long p = 2; p * p <= bound; ++p)
+        if ((*sieve)[p] == 0)
+            for (long j = p * p; j <= bound; j += p)
+                if ((*sieve)[j] == 0)
+                    (*sieve)[j] = static_cast<std::uint16_t>(p);
+
+    return sieve;
+}
+
+// replaced atomically by set_factorization_bound while other threads plan
+std::shared_ptr<FactorSieve const>& factor_sieve()
+{
+    static std::shared_ptr<FactorSieve const> sieve = make_factor_sieve(1 << 20);
+
+    return sieve;
+}
+
+}
+
+void set_factorization_bound(int bound)
+{
+    std::atomic_store(&factor_sieve(), make_factor_sieve(bound));
+}
+
+int factorization_bound()
+{
+    return static_cast<int>(std::atomic_load(&factor_sieve())->size()) - 1;
+}
+
 std::vector<int> compute_radices(int size, int option, int threshold) {
     assert( size > 0 );
     assert( 1 <= option and option <= 3 );
@@ -18,14 +64,26 @@ std::vector<int> compute_radices(int size, int option, int threshold) {
     vector<int> radices{};
 
     int n = size;
-    // first compute all factors of n
-    for (int i = 2; i * i <= n; ++i){
-        while (n % i == 0) {
-            n = n / i;
-            factors.push_back(i);
+    // first compute all factors of n in increasing order
+    std::shared_ptr<FactorSieve const> sieve = std::atomic_load(&factor_sieve());
+
+    if (static_cast<size_t>(n) < sieve->size())
+    {
+        for (int p = (*sieve)[n]; p != 0; p = (*sieve)[n]) {
+            n = n / p;
+            factors.push_back(p);
         }
     }
-    if (n > 1)
+    else
+    {
+        for (int i = 2; i * i <= n; ++i){
+            while (n % i == 0) {
+                n = n / i;
+                factors.push_back(i);
+            }
+        }
+    }
+    if (n > 1 or factors.empty())
         factors.push_back(n);
 
     assert( accumulate(factors.begin(), factors.end(), 1, std::multiplies<int>()) == size);
@@ -66,6 +124,19 @@ std::vector<int> compute_radices(int size, int option, int threshold) {
     return radices;
 }
 
+FftPlan make_plan(int size, int option, int threshold)
+{
+    return make_plan(size, option, threshold, FFT_FORWARD, 1, size);
+}
+
+FftPlan make_plan(int size, int option, int threshold, int direction, int stride, int distance)
+{
+    assert( size > 0 and stride != 0 );
+    assert( direction == FFT_FORWARD or direction == FFT_BACKWARD );
+
+    return FftPlan{size, compute_radices(size, option, threshold), direction, stride, distance};
+}
+
 std::vector<std::vector<std::complex<long double>>> precompute_phases(std::vector<int>& radices) 
 {
 
@@ -105,4 +176,74 @@ std::vector<std::vector<std::complex<long double>>> precompute_phases(std::vecto
     }
 
     return phase_table;
-}
\ No newline at end of file
+}
+
+TwiddleView shared_twiddles(int size, int count)
+{
+    assert( size > 0 and count > 0 and count <= size );
+
+    using Table = std::vector<std::complex<double>>;
+
+    static std::mutex                                           m;
+    static std::unordered_map<int, std::weak_ptr<Table const>>  tables;
+    static int                                                  largest     = 0;    // largest size ever cached
+    static size_t                                               live        = 0;    // entries after the last sweep
+
+    // the candidates are probed directly: the size itself, its small multiples and its multiples by
+    // powers of 2 (the tables of split-radix plans serve all smaller powers of 2), a few hash lookups
+    // however many tables are cached
+    auto find = [&]() -> TwiddleView {
+        auto probe = [&](long owner) -> TwiddleView {
+            auto it = tables.find(static_cast<int>(owner));
+            if (it == tables.end())
+                return TwiddleView{};
+
+            std::shared_ptr<Table const>    table   = it->second.lock();
+            size_t                          stride  = static_cast<size_t>(owner / size);
+
+            if (table and static_cast<size_t>(count - 1) * stride < table->size())
+                return TwiddleView{table, static_cast<int>(stride)};
+            return TwiddleView{};
+        };
+
+        for (long multiple = 1; multiple * size <= largest; multiple = multiple < 8 ? multiple + 1 : 2 * multiple)
+        {
+            TwiddleView view = probe(multiple * size);
+            if (view.table)
+                return view;
+        }
+        return TwiddleView{};
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(m);
+
+        TwiddleView view = find();
+        if (view.table)
+            return view;
+    }
+
+    // the table is computed outside of the lock, concurrent misses of the same size may both compute it
+    auto table = std::make_shared<Table>(count);
+    for (int k = 0; k < count; ++k)
+        (*table)[k] = static_cast<std::complex<double>>(std::polar(1.0L, -2 * PI / size * k));
+
+    std::lock_guard<std::mutex> lock(m);
+
+    TwiddleView view = find();
+    if (view.table)
+        return view;
+
+    tables[size]    = table;
+    largest         = std::max(largest, size);
+
+    // entries of freed tables are swept once the map has doubled since the last sweep, amortized O(1) per insertion
+    if (tables.size() > 2 * live + 64)
+    {
+        for (auto it = tables.begin(); it != tables.end(); )
+            it = it->second.expired() ? tables.erase(it) : std::next(it);
+        live = tables.size();
+    }
+
+    return TwiddleView{table, 1};
+}
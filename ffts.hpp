@@ -2,6 +2,7 @@
 #define FFTS_H_
 
 #include <stack>
+#include <memory>
 #include <vector>
 #include <cassert>
 #include <complex>
@@ -9,14 +10,57 @@
 #include <algorithm>
 #include <iostream>
 
+#include "AlignedAllocator.hpp"
 #include "StridedVector.hpp"
 
 constexpr auto PI = 3.14159265358979323846264338327950288419716939937510L;
 
+// sign of the exponent of the transform, as in FFTW the backward transform is not normalized
+constexpr int FFT_FORWARD   = -1;
+constexpr int FFT_BACKWARD  = +1;
+
 std::vector<int> compute_radices(int size, int option, int threshold);
 
+// compute_radices looks up the factors of sizes up to the bound in a sieve of smallest prime
+// factors (2 bytes per size, 1 << 20 by default) and factors larger sizes by trial division
+void set_factorization_bound(int bound);
+
+int factorization_bound();
+
 std::vector<std::vector<std::complex<long double>>> precompute_phases(std::vector<int>& radices);
 
+// W_size^k = table[k * stride] for the k the table covers, a table of the first C roots of size N
+// serves the first count roots of size n with (count - 1) * N / n < C when N / n is at most 8 or a power of 2
+struct TwiddleView
+{
+    std::shared_ptr<std::vector<std::complex<double>> const>    table;
+    int                                                         stride  = 1;
+
+    std::complex<double> operator[](int k) const { return (*table)[static_cast<size_t>(k) * stride]; };
+};
+
+// the first count twiddle factors of size from a process-wide cache of tables, a table is computed
+// once and freed when the last plan referring to it is destroyed
+TwiddleView shared_twiddles(int size, int count);
+
+inline TwiddleView shared_twiddles(int size) { return shared_twiddles(size, size); }
+
+// setup of a transform of fixed size that can be reused for many inputs,
+// element i of block b is located at b * distance + i * stride
+struct FftPlan
+{
+    int                 size;
+    std::vector<int>    radices;
+    int                 direction   = FFT_FORWARD;
+    int                 stride      = 1;
+    int                 distance    = 0;    // make_plan sets the layout, 0 is only valid for single blocks
+};
+
+// plan of a forward transform of contiguous blocks
+FftPlan make_plan(int size, int option, int threshold);
+
+FftPlan make_plan(int size, int option, int threshold, int direction, int stride, int distance);
+
 template <typename InputIt>
 std::vector<int> compute_digits(int value, InputIt radix_low, InputIt radix_high) 
 {
@@ -59,7 +103,7 @@ int reverse_digits(int value, InputIt radix_low, InputIt radix_high) {
 
 // permute elements of a vector by reversing the digits of the indices
 template <typename T>
-void permute_by_digit_reversal(std::vector<T>& v, std::vector<int>& radices)
+void permute_by_digit_reversal(FftBuffer<T>& v, std::vector<int> const& radices)
 {
     std::vector<int> permutation(v.size(), 0);
     
@@ -67,7 +111,7 @@ void permute_by_digit_reversal(std::vector<T>& v, std::vector<int>& radices)
         permutation[reverse_digits(i, radices.rbegin(), radices.rend())] = i;
 
     // apply permutation
-    std::vector<T> w;
+    FftBuffer<T> w;
     w.reserve(v.size());
     for (size_t i = 0; i < v.size(); i++)
         w.push_back(std::move(v[permutation[i]]));
@@ -76,12 +120,12 @@ void permute_by_digit_reversal(std::vector<T>& v, std::vector<int>& radices)
 
 // Discrete Fourier Transform by matrix multiplication O(n^2) runtime complexity
 template <typename complex_t>
-std::vector<complex_t> dft_matrix_mult(std::vector<complex_t> &in)
+FftBuffer<complex_t> dft_matrix_mult(FftBuffer<complex_t> &in)
 {
     
     int size = static_cast<int>(in.size());
     
-    std::vector<complex_t> out;
+    FftBuffer<complex_t> out;
     out.resize(size);
 
     complex_t y;
@@ -109,6 +153,44 @@ std::vector<complex_t> dft_matrix_mult(std::vector<complex_t> &in)
 }
 
 
+// butterfly of the depth-first FFT for the rows k0_begin <= k0 < k0_end,
+// combines the transformed columns into buffer[k1 * rest + k0]
+template <typename complex_t>
+void butterfly_recursive(std::vector<StridedVector<complex_t>>& columns, int k0_begin, int k0_end, FftBuffer<complex_t>& buffer)
+{
+    int radix   = static_cast<int>(columns.size());
+    int rest    = static_cast<int>(columns[0].size());
+    int size    = radix * rest;
+
+    complex_t y;
+    complex_t phase_step;
+    complex_t twiddle_factor_step;
+
+    for (int k0 = k0_begin; k0 < k0_end; ++k0)
+    {
+        
+        twiddle_factor_step = static_cast<complex_t>(std::polar(1.0L, -2 * PI / size * k0));
+
+        for (int k1 = 0; k1 < radix; ++k1)
+        {
+
+            phase_step  = static_cast<complex_t>(std::polar(1.0L, -2 * PI / radix * k1));
+            y           = 0.0;
+
+            for (int j0 = radix - 1; j0 >= 0; --j0)
+            {
+
+                y   = y * twiddle_factor_step * phase_step + columns[j0][k0];
+
+            }
+
+            buffer[k1 * rest + k0] = y;
+
+        }
+
+    }
+}
+
 template <typename complex_t>
 void solve_dft_recursive(StridedVector<complex_t>& in, std::vector<int> radices)
 {
@@ -122,7 +204,7 @@ void solve_dft_recursive(StridedVector<complex_t>& in, std::vector<int> radices)
     if (radices.size() == 1)
     {
         // calculate DFT in O(n^2)
-        std::vector<complex_t> buffer(size, 0.0);
+        FftBuffer<complex_t> buffer(size, 0.0);
         complex_t y;
         for (int k = 0; k < size; ++k)
         {
@@ -161,33 +243,9 @@ void solve_dft_recursive(StridedVector<complex_t>& in, std::vector<int> radices)
         }
 
         // butterfly: DFT(in, i * radix + j)
-        complex_t y;
-        complex_t twiddle_factor_step;
-        std::vector<complex_t> buffer(size, 0.0);
-        
-        for (int k0 = 0; k0 < rest; ++k0)
-        {
-            
-            twiddle_factor_step = static_cast<complex_t>(std::polar(1.0L, -2 * PI / size * k0));
-
-            for (int k1 = 0; k1 < radix; ++k1)
-            {
-
-                phase_step  = static_cast<complex_t>(std::polar(1.0L, -2 * PI / radix * k1));
-                y           = 0.0;
-
-                for (int j0 = radix - 1; j0 >= 0; --j0)
-                {
-
-                    y   = y * twiddle_factor_step * phase_step + columns[j0][k0];
+        FftBuffer<complex_t> buffer(size, 0.0);
 
-                }
-
-                buffer[k1 * rest + k0] = y;
-
-            }
-
-        }
+        butterfly_recursive(columns, 0, rest, buffer);
 
         for (int k = 0; k < size; ++k)
             in[k] = buffer[k];
@@ -197,7 +255,7 @@ void solve_dft_recursive(StridedVector<complex_t>& in, std::vector<int> radices)
 
 // Cooley-Tuckey type implementation of the DFT by decimation in time, depth-first, mixed-radix
 template <typename complex_t>
-std::vector<complex_t> fft_recursive_depth_first(std::vector<complex_t>& x, std::vector<int>& radices)
+FftBuffer<complex_t> fft_recursive_depth_first(FftBuffer<complex_t>& x, std::vector<int> const& radices)
 {
     assert( std::accumulate(radices.begin(), radices.end(), 1, std::multiplies<int>()) == static_cast<int>(x.size()) );
 
@@ -209,42 +267,58 @@ std::vector<complex_t> fft_recursive_depth_first(std::vector<complex_t>& x, std:
 }
 
 
-// Cooley-Tuckey type implementation of the DFT by decimation in time, breadth-first, mixed-radix
-template <typename complex_t>
-std::vector<complex_t> fft_iterative_breadth_first(std::vector<complex_t> &x, std::vector<int> &radices)
+// Cooley-Tuckey type implementation of the DFT by decimation in time, breadth-first, mixed-radix,
+// with caller-provided operations fused into the first and the last butterfly stage:
+// the first stage reads element n as load(n) and the last stage hands each bin to store(k, X[k])
+// at its digit-reversed index, so that e.g. windowing and type conversion or |X|^2 and writing to
+// the consumer's buffer need no extra passes and there is no separate digit reversal. All elements
+// are loaded before the first bin is stored. x is the working storage of the stages in between
+// and is resized to the size of the transform. root(m, k) returns W_m^k for m dividing the size.
+template <typename complex_t, typename Load, typename Store, typename Root>
+void fft_iterative_breadth_first_fused(FftBuffer<complex_t>& x, std::vector<int> const& radices, Load const& load, Store const& store, Root const& root)
 {
-    assert( std::accumulate(radices.begin(), radices.end(), 1, std::multiplies<int>()) == static_cast<int>(x.size()) );
+    int n = std::accumulate(radices.begin(), radices.end(), 1, std::multiplies<int>());
+
+    x.resize(n);
 
     std::vector<int> prev_radices{};
     // base cases
     int radix   = radices[0];
     int size    = radix;
-    int nrows   = static_cast<int>(x.size()) / radix;
+    int nrows   = n / radix;
     
     complex_t phase_step;
 
-    std::vector<complex_t> buffer(radix, 0.0);
+    FftBuffer<complex_t> buffer(radix, 0.0);
+    FftBuffer<complex_t> column(radix, 0.0);
     for (int low = 0; low < nrows; ++low)
     {
+
+        for (int j = 0; j < radix; ++j)
+            column[j] = load(j * nrows + low);
         
         for (int k = 0; k < radix; ++k)
         {
         
-            phase_step  = static_cast<complex_t>(std::polar(1.0L, -2 * PI / size * k));
+            phase_step  = root(size, k);
         
             for (int j = radix - 1; j >= 0; --j)
             {
         
                 buffer[k]   *= phase_step;
-                buffer[k]   += x[j * nrows + low];
+                buffer[k]   += column[j];
         
             }
         }
         
+        // with a single stage nrows is 1 and bin k is buffer[k]
         for (int k = 0; k < radix; ++k)
         {
 
-            x[k * nrows + low] = buffer[k];
+            if (radices.size() == 1)
+                store(k, buffer[k]);
+            else
+                x[k * nrows + low] = buffer[k];
             buffer[k] = 0.0;
 
         }
@@ -262,14 +336,17 @@ std::vector<complex_t> fft_iterative_breadth_first(std::vector<complex_t> &x, st
         size    = size * radix;
         nrows   = nrows / radix;
 
-        buffer  = std::vector<complex_t>(radix, 0.0);
+        buffer  = FftBuffer<complex_t>(radix, 0.0);
         int l;
 
+        // in the last stage nrows is 1 and element high * radix + k holds the bin with the reversed digits
+        bool const last = i + 1 == radices.size();
+
         for (int high = 0; high < size / radix; ++high)
         {
         
             l                   = reverse_digits(high, prev_radices.rbegin(), prev_radices.rend());
-            twiddle_factor_step = static_cast<complex_t>(std::polar(1.0L, -2 * PI / size * l));
+            twiddle_factor_step = root(size, l);
 
             for (int low = 0; low < nrows; ++low)
             {
@@ -277,7 +354,7 @@ std::vector<complex_t> fft_iterative_breadth_first(std::vector<complex_t> &x, st
                 for (int k = 0; k < radix; ++k)
                 {
             
-                    phase_step  = static_cast<complex_t>(std::polar(1.0L, -2 * PI / radix * k));
+                    phase_step  = root(radix, k);
             
                     for (int j = radix - 1; j >= 0; --j)
                     {
@@ -291,7 +368,10 @@ std::vector<complex_t> fft_iterative_breadth_first(std::vector<complex_t> &x, st
                 for (int k = 0; k < radix; ++k)
                 {
 
-                    x[(high * radix + k) * nrows + low] = buffer[k];
+                    if (last)
+                        store(reverse_digits(high * radix + k, radices.rbegin(), radices.rend()), buffer[k]);
+                    else
+                        x[(high * radix + k) * nrows + low] = buffer[k];
                     buffer[k] = 0.0;
 
                 }
@@ -301,9 +381,95 @@ std::vector<complex_t> fft_iterative_breadth_first(std::vector<complex_t> &x, st
         prev_radices.push_back(radix);
 
     }
-    permute_by_digit_reversal<complex_t>(x, radices);
+}
+
+// fused transform with the roots of unity evaluated in long double when they are needed
+template <typename complex_t, typename Load, typename Store>
+void fft_iterative_breadth_first_fused(FftBuffer<complex_t>& x, std::vector<int> const& radices, Load const& load, Store const& store)
+{
+    fft_iterative_breadth_first_fused(x, radices, load, store,
+            [](int m, int k) { return static_cast<complex_t>(std::polar(1.0L, -2 * PI / m * k)); });
+}
+
+// Cooley-Tuckey type implementation of the DFT by decimation in time, breadth-first, mixed-radix
+template <typename complex_t>
+FftBuffer<complex_t> fft_iterative_breadth_first(FftBuffer<complex_t> &x, std::vector<int> const& radices)
+{
+    assert( std::accumulate(radices.begin(), radices.end(), 1, std::multiplies<int>()) == static_cast<int>(x.size()) );
+
+    // the stages in between work on storage of the thread that is reused by later calls,
+    // x is read by the first stage and receives the bins from the last stage
+    static thread_local FftBuffer<complex_t> work;
+
+    fft_iterative_breadth_first_fused(work, radices,
+            [&](int n) { return x[n]; },
+            [&](int k, complex_t const& y) { x[k] = y; });
+
+    return x;
+}
+
+// as above with the roots of unity read from a table of the size of the transform or a multiple of it,
+// e.g. the shared_twiddles(x.size()) of a split-radix plan of the same size
+template <typename complex_t>
+FftBuffer<complex_t> fft_iterative_breadth_first(FftBuffer<complex_t> &x, std::vector<int> const& radices, TwiddleView const& twiddles)
+{
+    int n = static_cast<int>(x.size());
+
+    assert( std::accumulate(radices.begin(), radices.end(), 1, std::multiplies<int>()) == n );
+    assert( twiddles.table and static_cast<size_t>(n - 1) * static_cast<size_t>(twiddles.stride) < twiddles.table->size() );
+
+    static thread_local FftBuffer<complex_t> work;
+
+    fft_iterative_breadth_first_fused(work, radices,
+            [&](int i) { return x[i]; },
+            [&](int k, complex_t const& y) { x[k] = y; },
+            [&](int m, int k) { return static_cast<complex_t>(twiddles[n / m * k]); });
 
     return x;
 }
 
+// transform howmany blocks of plan.size elements with the operations fused into the first and the last pass,
+// element n of block b is load(b, n), bin k of block b is handed to store(b, k, X[k]),
+// the backward transform conjugates the loaded elements and the stored bins
+template <typename complex_t, typename Load, typename Store>
+void execute_batch_fused(FftPlan const& plan, int howmany, Load const& load, Store const& store, FftBuffer<complex_t>& work)
+{
+    assert( howmany >= 0 );
+
+    // the backward transform is the conjugate of the forward transform of the conjugate
+    bool conjugate = plan.direction == FFT_BACKWARD;
+
+    for (int b = 0; b < howmany; ++b)
+        fft_iterative_breadth_first_fused(work, plan.radices,
+                [&](int n) {
+                    complex_t x = load(b, n);
+                    return conjugate ? std::conj(x) : x;
+                },
+                [&](int k, complex_t const& y) { store(b, k, conjugate ? std::conj(y) : y); });
+}
+
+// transform howmany blocks of plan.size elements read from in in the layout of the plan and written
+// to out with out_stride and out_distance, the first stage reads all elements of a block before the
+// bins are written, so in and out may be the same array if both layouts are equal
+template <typename complex_t>
+void execute_batch(FftPlan const& plan, complex_t const* in, complex_t* out, int out_stride, int out_distance, int howmany, FftBuffer<complex_t>& work)
+{
+    assert( howmany == 0 or (in != nullptr and out != nullptr) );
+    assert( howmany <= 1 or (plan.distance != 0 and out_distance != 0) );
+
+    execute_batch_fused(plan, howmany,
+            [&](int b, int i) { return in[static_cast<ptrdiff_t>(b) * plan.distance + static_cast<ptrdiff_t>(i) * plan.stride]; },
+            [&](int b, int k, complex_t const& y) { out[static_cast<ptrdiff_t>(b) * out_distance + static_cast<ptrdiff_t>(k) * out_stride] = y; },
+            work);
+}
+
+// transform howmany blocks of plan.size elements in the layout of the plan starting at data
+template <typename complex_t>
+void execute_batch(FftPlan const& plan, complex_t* data, int howmany, FftBuffer<complex_t>& work)
+{
+    assert( howmany == 0 or data != nullptr );
+
+    execute_batch(plan, data, data, plan.stride, plan.distance, howmany, work);
+}
+
 #endif
@@ -0,0 +1,248 @@
+// Drop-in replacement of the commonly used double precision subset of the FFTW3 API backed
+// by the own plans. Built as libfftw3shim.so, programs compiled against fftw3.h can link
+// against it instead of libfftw3 or load it with LD_PRELOAD.
+//
+// Supported: fftw_plan_dft_1d/_2d, fftw_plan_dft (rank 1 and 2), fftw_plan_many_dft and
+// fftw_plan_guru64_dft (rank 1, at most one batch dimension), fftw_plan_dft_r2c_1d and
+// fftw_plan_dft_c2r_1d, fftw_execute, the new-array execute functions, fftw_destroy_plan,
+// fftw_malloc/fftw_free/fftw_alloc_*, fftw_cleanup. Planner flags are ignored, the arrays are
+// never touched while planning and the inputs of c2r transforms are preserved. Transforms
+// that are not supported yield a null plan, as FFTW does for impossible plans.
+
+#include <new>
+#include <limits>
+#include <memory>
+#include <complex>
+#include <cstdlib>
+#include <cstddef>
+
+#include "ffts.hpp"
+#include "real_ffts.hpp"
+#include "PlanCache.hpp"
+
+// types of fftw3.h, which is not needed to build the shim
+extern "C"
+{
+typedef double fftw_complex[2];
+typedef struct fftw_plan_s* fftw_plan;
+
+typedef struct fftw_iodim64_do_not_use_me
+{
+    ptrdiff_t n;
+    ptrdiff_t is;
+    ptrdiff_t os;
+} fftw_iodim64;
+}
+
+// howmany transforms of n0 x n1 elements (n0 = 1 for rank 1), complex transforms of rank 1
+// read and write with the strides and distances of the plan, 2-D transforms are contiguous
+struct fftw_plan_s
+{
+    enum class Kind {complex_dft, real_to_complex, complex_to_real};
+
+    Kind                            kind;
+    int                             n0;
+    int                             n1;
+    int                             howmany;
+    int                             ostride;
+    int                             odist;
+    std::shared_ptr<FftPlan const>  rows;       // in the input layout
+    std::shared_ptr<FftPlan const>  columns;    // in place on the output
+    RealFftPlan                     real_plan;
+    void*                           in;
+    void*                           out;
+};
+
+namespace
+{
+
+using complex_t = std::complex<double>;
+
+bool fits_int(ptrdiff_t value)
+{
+    return value >= std::numeric_limits<int>::min() and value <= std::numeric_limits<int>::max();
+}
+
+FftBuffer<complex_t>& workspace()
+{
+    static thread_local FftBuffer<complex_t> work;
+    return work;
+}
+
+std::shared_ptr<FftPlan const> cached_plan(int size, int sign, int stride, int distance)
+{
+    return PlanCache::global().get(PlanKey{size, static_cast<int>(sizeof(double)), sign, stride, distance});
+}
+
+fftw_plan plan_complex(int n0, int n1, int howmany, int istride, int idist, int ostride, int odist, int sign, fftw_complex* in, fftw_complex* out)
+{
+    if (n0 < 1 or n1 < 1 or howmany < 0 or (sign != FFT_FORWARD and sign != FFT_BACKWARD))
+        return nullptr;
+
+    fftw_plan p = new (std::nothrow) fftw_plan_s{fftw_plan_s::Kind::complex_dft, n0, n1, howmany, ostride, odist, nullptr, nullptr, {}, in, out};
+
+    if (p == nullptr)
+        return nullptr;
+
+    p->rows = cached_plan(n1, sign, istride, idist);
+    if (n0 > 1)
+        p->columns = cached_plan(n0, sign, n1, 1);
+
+    return p;
+}
+
+fftw_plan plan_real(fftw_plan_s::Kind kind, int n, void* in, void* out)
+{
+    if (n < 1)
+        return nullptr;
+
+    return new (std::nothrow) fftw_plan_s{kind, 1, n, 1, 1, n / 2 + 1, nullptr, nullptr,
+            make_real_plan(n, PlanCache::global().option(), PlanCache::global().threshold()), in, out};
+}
+
+void execute_complex(fftw_plan_s const* p, fftw_complex* in, fftw_complex* out)
+{
+    auto* x = reinterpret_cast<complex_t*>(in);
+    auto* y = reinterpret_cast<complex_t*>(out);
+
+    if (p->n0 == 1)
+    {
+        execute_batch(*p->rows, x, y, p->ostride, p->odist, p->howmany, workspace());
+        return;
+    }
+
+    // rows into the output, then the columns in place
+    execute_batch(*p->rows, x, y, 1, p->n1, p->n0, workspace());
+    execute_batch(*p->columns, y, p->n1, workspace());
+}
+
+}
+
+extern "C"
+{
+
+void* fftw_malloc(size_t n)
+{
+    void* p = nullptr;
+
+    if (posix_memalign(&p, CACHE_LINE_SIZE, n == 0 ? 1 : n) != 0)
+        return nullptr;
+
+    return p;
+}
+
+void fftw_free(void* p)
+{
+    free(p);
+}
+
+fftw_complex* fftw_alloc_complex(size_t n)
+{
+    return static_cast<fftw_complex*>(fftw_malloc(n * sizeof(fftw_complex)));
+}
+
+double* fftw_alloc_real(size_t n)
+{
+    return static_cast<double*>(fftw_malloc(n * sizeof(double)));
+}
+
+fftw_plan fftw_plan_dft_1d(int n, fftw_complex* in, fftw_complex* out, int sign, unsigned)
+{
+    return plan_complex(1, n, 1, 1, n, 1, n, sign, in, out);
+}
+
+fftw_plan fftw_plan_dft_2d(int n0, int n1, fftw_complex* in, fftw_complex* out, int sign, unsigned)
+{
+    return plan_complex(n0, n1, 1, 1, n1, 1, n1, sign, in, out);
+}
+
+fftw_plan fftw_plan_dft(int rank, int const* n, fftw_complex* in, fftw_complex* out, int sign, unsigned flags)
+{
+    if (rank == 1)
+        return fftw_plan_dft_1d(n[0], in, out, sign, flags);
+    if (rank == 2)
+        return fftw_plan_dft_2d(n[0], n[1], in, out, sign, flags);
+
+    return nullptr;
+}
+
+// the embeddings are implied by the strides and distances for rank 1
+fftw_plan fftw_plan_many_dft(int rank, int const* n, int howmany,
+        fftw_complex* in, int const*, int istride, int idist,
+        fftw_complex* out, int const*, int ostride, int odist, int sign, unsigned)
+{
+    if (rank != 1)
+        return nullptr;
+
+    return plan_complex(1, n[0], howmany, istride, idist, ostride, odist, sign, in, out);
+}
+
+fftw_plan fftw_plan_guru64_dft(int rank, fftw_iodim64 const* dims, int howmany_rank, fftw_iodim64 const* howmany_dims,
+        fftw_complex* in, fftw_complex* out, int sign, unsigned)
+{
+    if (rank != 1 or howmany_rank < 0 or howmany_rank > 1)
+        return nullptr;
+
+    fftw_iodim64 batch = howmany_rank == 1 ? howmany_dims[0] : fftw_iodim64{1, 0, 0};
+
+    if (not (fits_int(dims[0].n) and fits_int(dims[0].is) and fits_int(dims[0].os)
+             and fits_int(batch.n) and fits_int(batch.is) and fits_int(batch.os)))
+        return nullptr;
+
+    return plan_complex(1, static_cast<int>(dims[0].n), static_cast<int>(batch.n),
+            static_cast<int>(dims[0].is), static_cast<int>(batch.is), static_cast<int>(dims[0].os), static_cast<int>(batch.os),
+            sign, in, out);
+}
+
+fftw_plan fftw_plan_dft_r2c_1d(int n, double* in, fftw_complex* out, unsigned)
+{
+    return plan_real(fftw_plan_s::Kind::real_to_complex, n, in, out);
+}
+
+fftw_plan fftw_plan_dft_c2r_1d(int n, fftw_complex* in, double* out, unsigned)
+{
+    return plan_real(fftw_plan_s::Kind::complex_to_real, n, in, out);
+}
+
+void fftw_execute_dft(fftw_plan const p, fftw_complex* in, fftw_complex* out)
+{
+    execute_complex(p, in, out);
+}
+
+void fftw_execute_dft_r2c(fftw_plan const p, double* in, fftw_complex* out)
+{
+    fft_r2c(p->real_plan, in, reinterpret_cast<complex_t*>(out), workspace());
+}
+
+void fftw_execute_dft_c2r(fftw_plan const p, fftw_complex* in, double* out)
+{
+    fft_c2r(p->real_plan, reinterpret_cast<complex_t const*>(in), out, workspace());
+}
+
+void fftw_execute(fftw_plan const p)
+{
+    switch (p->kind)
+    {
+    case fftw_plan_s::Kind::complex_dft:
+        fftw_execute_dft(p, static_cast<fftw_complex*>(p->in), static_cast<fftw_complex*>(p->out));
+        break;
+    case fftw_plan_s::Kind::real_to_complex:
+        fftw_execute_dft_r2c(p, static_cast<double*>(p->in), static_cast<fftw_complex*>(p->out));
+        break;
+    case fftw_plan_s::Kind::complex_to_real:
+        fftw_execute_dft_c2r(p, static_cast<fftw_complex*>(p->in), static_cast<double*>(p->out));
+        break;
+    }
+}
+
+void fftw_destroy_plan(fftw_plan p)
+{
+    delete p;
+}
+
+void fftw_cleanup()
+{
+    PlanCache::global().clear();
+}
+
+}
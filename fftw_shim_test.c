@@ -0,0 +1,254 @@
+/* Test of libfftw3shim.so through its C ABI: every supported planner against direct sums.
+ * The declarations are those of fftw3.h, so that the test builds without FFTW installed.
+ * Exits with 1 if any transform differs from the direct sum. */
+
+#include <math.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef double fftw_complex[2];
+typedef struct fftw_plan_s* fftw_plan;
+
+typedef struct fftw_iodim64_do_not_use_me
+{
+    ptrdiff_t n;
+    ptrdiff_t is;
+    ptrdiff_t os;
+} fftw_iodim64;
+
+#define FFTW_FORWARD    (-1)
+#define FFTW_BACKWARD   (+1)
+#define FFTW_ESTIMATE   (1U << 6)
+
+void*           fftw_malloc(size_t n);
+void            fftw_free(void* p);
+fftw_complex*   fftw_alloc_complex(size_t n);
+double*         fftw_alloc_real(size_t n);
+fftw_plan       fftw_plan_dft_1d(int n, fftw_complex* in, fftw_complex* out, int sign, unsigned flags);
+fftw_plan       fftw_plan_dft_2d(int n0, int n1, fftw_complex* in, fftw_complex* out, int sign, unsigned flags);
+fftw_plan       fftw_plan_many_dft(int rank, const int* n, int howmany, fftw_complex* in, const int* inembed, int istride, int idist,
+                                   fftw_complex* out, const int* onembed, int ostride, int odist, int sign, unsigned flags);
+fftw_plan       fftw_plan_guru64_dft(int rank, const fftw_iodim64* dims, int howmany_rank, const fftw_iodim64* howmany_dims,
+                                     fftw_complex* in, fftw_complex* out, int sign, unsigned flags);
+fftw_plan       fftw_plan_dft_r2c_1d(int n, double* in, fftw_complex* out, unsigned flags);
+fftw_plan       fftw_plan_dft_c2r_1d(int n, fftw_complex* in, double* out, unsigned flags);
+void            fftw_execute(const fftw_plan p);
+void            fftw_execute_dft(const fftw_plan p, fftw_complex* in, fftw_complex* out);
+void            fftw_destroy_plan(fftw_plan p);
+void            fftw_cleanup(void);
+
+static int failures = 0;
+
+static void fill(fftw_complex* x, size_t n, int seed)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        x[i][0] = sin(0.37 * (double) (i + 1) * seed);
+        x[i][1] = cos(0.11 * (double) (i * i % 97) + seed);
+    }
+}
+
+/* y[k * ys] = sum_j x[j * xs] exp(sign 2 pi i j k / n) */
+static void direct_dft(const fftw_complex* x, ptrdiff_t xs, fftw_complex* y, ptrdiff_t ys, int n, int sign)
+{
+    for (int k = 0; k < n; ++k)
+    {
+        long double re = 0, im = 0;
+
+        for (int j = 0; j < n; ++j)
+        {
+            long double phase = sign * 2 * acosl(-1) * (long double) ((long) j * k % n) / n;
+            re += x[j * xs][0] * cosl(phase) - x[j * xs][1] * sinl(phase);
+            im += x[j * xs][0] * sinl(phase) + x[j * xs][1] * cosl(phase);
+        }
+
+        y[k * ys][0] = (double) re;
+        y[k * ys][1] = (double) im;
+    }
+}
+
+static double max_difference(const fftw_complex* a, const fftw_complex* b, size_t n)
+{
+    double error = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        error = fmax(error, hypot(a[i][0] - b[i][0], a[i][1] - b[i][1]));
+
+    return error;
+}
+
+static void report(const char* name, double error, int size)
+{
+    int failed = !(error <= 1e-12 * size);
+
+    failures += failed;
+    printf("%-44s %10.3e  %s\n", name, error, failed ? "FAILED" : "ok");
+}
+
+static void test_1d(int n, int sign)
+{
+    fftw_complex*   in          = fftw_alloc_complex((size_t) n);
+    fftw_complex*   out         = fftw_alloc_complex((size_t) n);
+    fftw_complex*   expected    = fftw_alloc_complex((size_t) n);
+    fftw_plan       p           = fftw_plan_dft_1d(n, in, out, sign, FFTW_ESTIMATE);
+    char            name[64];
+
+    fill(in, (size_t) n, 1);
+    direct_dft(in, 1, expected, 1, n, sign);
+    fftw_execute(p);
+
+    snprintf(name, sizeof name, "dft_1d %d %s", n, sign == FFTW_FORWARD ? "forward" : "backward");
+    report(name, max_difference(out, expected, (size_t) n), n);
+
+    /* new-array execution, in place */
+    fill(in, (size_t) n, 2);
+    direct_dft(in, 1, expected, 1, n, sign);
+    fftw_execute_dft(p, in, in);
+
+    snprintf(name, sizeof name, "execute_dft %d in place", n);
+    report(name, max_difference(in, expected, (size_t) n), n);
+
+    fftw_destroy_plan(p);
+    fftw_free(expected);
+    fftw_free(out);
+    fftw_free(in);
+}
+
+static void test_2d(int n0, int n1)
+{
+    size_t          n           = (size_t) n0 * (size_t) n1;
+    fftw_complex*   in          = fftw_alloc_complex(n);
+    fftw_complex*   out         = fftw_alloc_complex(n);
+    fftw_complex*   rows        = fftw_alloc_complex(n);
+    fftw_complex*   expected    = fftw_alloc_complex(n);
+    fftw_plan       p           = fftw_plan_dft_2d(n0, n1, in, out, FFTW_FORWARD, FFTW_ESTIMATE);
+    char            name[64];
+
+    fill(in, n, 3);
+    for (int r = 0; r < n0; ++r)
+        direct_dft(in + r * n1, 1, rows + r * n1, 1, n1, FFTW_FORWARD);
+    for (int c = 0; c < n1; ++c)
+        direct_dft(rows + c, n1, expected + c, n1, n0, FFTW_FORWARD);
+
+    fftw_execute(p);
+
+    snprintf(name, sizeof name, "dft_2d %dx%d", n0, n1);
+    report(name, max_difference(out, expected, n), (int) n);
+
+    fftw_destroy_plan(p);
+    fftw_free(expected);
+    fftw_free(rows);
+    fftw_free(out);
+    fftw_free(in);
+}
+
+/* howmany interleaved inputs (stride howmany, distance 1) into contiguous outputs, with both planners */
+static void test_many(int n, int howmany, int use_guru)
+{
+    size_t          total       = (size_t) n * (size_t) howmany;
+    fftw_complex*   in          = fftw_alloc_complex(total);
+    fftw_complex*   out         = fftw_alloc_complex(total);
+    fftw_complex*   expected    = fftw_alloc_complex(total);
+    fftw_plan       p;
+    char            name[64];
+
+    if (use_guru)
+    {
+        fftw_iodim64 dim    = {n, howmany, 1};
+        fftw_iodim64 batch  = {howmany, 1, n};
+        p = fftw_plan_guru64_dft(1, &dim, 1, &batch, in, out, FFTW_BACKWARD, FFTW_ESTIMATE);
+    }
+    else
+        p = fftw_plan_many_dft(1, &n, howmany, in, NULL, howmany, 1, out, NULL, 1, n, FFTW_BACKWARD, FFTW_ESTIMATE);
+
+    fill(in, total, 4);
+    for (int b = 0; b < howmany; ++b)
+        direct_dft(in + b, howmany, expected + (size_t) b * n, 1, n, FFTW_BACKWARD);
+
+    fftw_execute(p);
+
+    snprintf(name, sizeof name, "%s %d x %d interleaved backward", use_guru ? "guru64_dft" : "many_dft", howmany, n);
+    report(name, max_difference(out, expected, total), n);
+
+    fftw_destroy_plan(p);
+    fftw_free(expected);
+    fftw_free(out);
+    fftw_free(in);
+}
+
+static void test_real(int n)
+{
+    int             nbins       = n / 2 + 1;
+    double*         x           = fftw_alloc_real((size_t) n);
+    double*         y           = fftw_alloc_real((size_t) n);
+    fftw_complex*   spectrum    = fftw_alloc_complex((size_t) nbins);
+    fftw_complex*   copy        = fftw_alloc_complex((size_t) nbins);
+    fftw_complex*   complex_x   = fftw_alloc_complex((size_t) n);
+    fftw_complex*   expected    = fftw_alloc_complex((size_t) n);
+    fftw_plan       r2c         = fftw_plan_dft_r2c_1d(n, x, spectrum, FFTW_ESTIMATE);
+    fftw_plan       c2r         = fftw_plan_dft_c2r_1d(n, spectrum, y, FFTW_ESTIMATE);
+    char            name[64];
+    double          error       = 0;
+
+    for (int i = 0; i < n; ++i)
+    {
+        x[i]            = sin(0.3 * i) + 0.25 * cos(1.7 * i * i);
+        complex_x[i][0] = x[i];
+        complex_x[i][1] = 0;
+    }
+    direct_dft(complex_x, 1, expected, 1, n, FFTW_FORWARD);
+
+    fftw_execute(r2c);
+
+    snprintf(name, sizeof name, "dft_r2c_1d %d", n);
+    report(name, max_difference(spectrum, expected, (size_t) nbins), n);
+
+    /* the unnormalized inverse gives n x, the input of c2r is preserved */
+    memcpy(copy, spectrum, sizeof(fftw_complex) * (size_t) nbins);
+    fftw_execute(c2r);
+
+    for (int i = 0; i < n; ++i)
+        error = fmax(error, fabs(y[i] / n - x[i]));
+
+    snprintf(name, sizeof name, "dft_c2r_1d %d round trip", n);
+    report(name, error, n);
+    report("dft_c2r_1d preserves its input", max_difference(spectrum, copy, (size_t) nbins), 1);
+
+    fftw_destroy_plan(c2r);
+    fftw_destroy_plan(r2c);
+    fftw_free(expected);
+    fftw_free(complex_x);
+    fftw_free(copy);
+    fftw_free(spectrum);
+    fftw_free(y);
+    fftw_free(x);
+}
+
+int main(void)
+{
+    int invalid = 0;
+
+    printf("FFTW shim test: planners of libfftw3shim.so against direct sums\n");
+
+    test_1d(64, FFTW_FORWARD);
+    test_1d(60, FFTW_BACKWARD);
+    test_1d(97, FFTW_FORWARD);
+    test_2d(6, 10);
+    test_2d(16, 8);
+    test_many(30, 3, 0);
+    test_many(32, 4, 1);
+    test_real(30);
+    test_real(31);
+
+    /* impossible plans are null, as in FFTW */
+    invalid = fftw_plan_dft_1d(0, NULL, NULL, FFTW_FORWARD, FFTW_ESTIMATE) != NULL;
+    report("null plan for size 0", invalid, 1);
+
+    fftw_cleanup();
+
+    printf("%d failures\n\n", failures);
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
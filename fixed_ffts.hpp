@@ -0,0 +1,201 @@
+#ifndef FIXED_FFTS_H_
+#define FIXED_FFTS_H_
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <utility>
+
+#include "ffts.hpp"
+
+// FFTs of sizes known at compile time: the factorization, the twiddle factors and
+// the digit reversal are resolved by the compiler, all loops run over compile-time
+// index sequences and unroll into straight-line code.
+
+namespace fixed_detail
+{
+
+// cos and sin by Taylor series, the argument is reduced to [-pi, pi]
+constexpr long double constexpr_cos(long double x)
+{
+    while (x > PI)
+        x -= 2 * PI;
+    while (x < -PI)
+        x += 2 * PI;
+
+    long double term    = 1.0L;
+    long double sum     = 1.0L;
+
+    for (int n = 1; n < 40; ++n)
+    {
+        term    *= -x * x / ((2 * n - 1) * (2 * n));
+        sum     += term;
+    }
+
+    return sum;
+}
+
+constexpr long double constexpr_sin(long double x)
+{
+    return constexpr_cos(x - PI / 2);
+}
+
+// radix of the first splitting step: 4 and 2 for even sizes, otherwise the smallest prime factor
+constexpr size_t first_radix(size_t n)
+{
+    if (n % 4 == 0 and n > 4)
+        return 4;
+    if (n % 2 == 0)
+        return 2;
+
+    for (size_t p = 3; p * p <= n; p += 2)
+        if (n % p == 0)
+            return p;
+
+    return n;
+}
+
+// W_N^j = exp(-2 pi i j / N) for 0 <= j < N
+template <typename complex_t, size_t N>
+struct Twiddles
+{
+    using real_t = typename complex_t::value_type;
+
+    static constexpr std::array<complex_t, N> compute()
+    {
+        std::array<complex_t, N> w{};
+        for (size_t j = 0; j < N; ++j)
+            w[j] = complex_t(static_cast<real_t>(constexpr_cos(-2 * PI * j / N)), static_cast<real_t>(constexpr_sin(-2 * PI * j / N)));
+        return w;
+    };
+
+    static constexpr std::array<complex_t, N> values = compute();
+};
+
+// call f(std::integral_constant<size_t, I>) for I = 0, ..., N - 1
+template <typename F, size_t... I>
+inline void static_for_impl(F&& f, std::index_sequence<I...>)
+{
+    (f(std::integral_constant<size_t, I>{}), ...);
+}
+
+template <size_t N, typename F>
+inline void static_for(F&& f)
+{
+    static_for_impl(std::forward<F>(f), std::make_index_sequence<N>{});
+}
+
+// in-place DFT of R values
+template <typename complex_t, size_t R>
+struct Codelet
+{
+    static inline void apply(complex_t* t)
+    {
+        std::array<complex_t, R> y{};
+
+        static_for<R>([&](auto k) {
+            static_for<R>([&](auto r) {
+                if constexpr (r == 0 or k == 0)
+                    y[k] += t[r];
+                else
+                    y[k] += t[r] * Twiddles<complex_t, R>::values[(r * k) % R];
+            });
+        });
+
+        static_for<R>([&](auto k) { t[k] = y[k]; });
+    };
+};
+
+template <typename complex_t>
+struct Codelet<complex_t, 1>
+{
+    static inline void apply(complex_t*) {};
+};
+
+template <typename complex_t>
+struct Codelet<complex_t, 2>
+{
+    static inline void apply(complex_t* t)
+    {
+        complex_t a = t[0];
+        t[0] = a + t[1];
+        t[1] = a - t[1];
+    };
+};
+
+template <typename complex_t>
+struct Codelet<complex_t, 4>
+{
+    static inline void apply(complex_t* t)
+    {
+        complex_t a0 = t[0] + t[2];
+        complex_t a1 = t[0] - t[2];
+        complex_t a2 = t[1] + t[3];
+        complex_t d  = t[1] - t[3];
+        // multiplication by -i
+        complex_t a3 = complex_t(d.imag(), -d.real());
+
+        t[0] = a0 + a2;
+        t[1] = a1 + a3;
+        t[2] = a0 - a2;
+        t[3] = a1 - a3;
+    };
+};
+
+// out[0, N) = DFT of in[0], in[Stride], ..., in[(N - 1) * Stride] by decimation in time:
+// the R sub-transforms of the decimated inputs are written to consecutive blocks of out,
+// so that the digit reversal is folded into the addressing of the input
+template <typename complex_t, size_t N, size_t Stride>
+struct FixedDft
+{
+    static constexpr size_t R = first_radix(N);
+    static constexpr size_t M = N / R;
+
+    static inline void apply(complex_t const* in, complex_t* out)
+    {
+        static_for<R>([&](auto r) {
+            FixedDft<complex_t, M, Stride * R>::apply(in + r * Stride, out + r * M);
+        });
+
+        static_for<M>([&](auto k2) {
+            std::array<complex_t, R> t;
+
+            static_for<R>([&](auto r) {
+                if constexpr (r * k2 == 0)
+                    t[r] = out[r * M + k2];
+                else
+                    t[r] = out[r * M + k2] * Twiddles<complex_t, N>::values[(r * k2) % N];
+            });
+
+            Codelet<complex_t, R>::apply(t.data());
+
+            static_for<R>([&](auto k1) { out[k2 + M * k1] = t[k1]; });
+        });
+    };
+};
+
+template <typename complex_t, size_t Stride>
+struct FixedDft<complex_t, 1, Stride>
+{
+    static inline void apply(complex_t const* in, complex_t* out)
+    {
+        out[0] = in[0];
+    };
+};
+
+}
+
+// forward FFT of a fixed size N, e.g. fft<16>(x) for x of type std::array<std::complex<float>, 16>
+template <size_t N, typename complex_t>
+std::array<complex_t, N> fft(std::array<complex_t, N> const& x)
+{
+    static_assert( N > 0, "the size of the transform must be positive" );
+
+    std::array<complex_t, N> y;
+
+    fixed_detail::FixedDft<complex_t, N, 1>::apply(x.data(), y.data());
+
+    return y;
+}
+
+#endif
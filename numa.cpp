@@ -0,0 +1,110 @@
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cassert>
+#include <thread>
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+
+#include "numa.hpp"
+
+std::vector<int> parse_cpu_list(std::string const& text)
+{
+    using std::string;
+    using std::vector;
+
+    vector<int>         cpus;
+    std::istringstream  stream(text);
+    string              range;
+
+    while (std::getline(stream, range, ','))
+    {
+        if (range.empty() or range == "\n")
+            continue;
+
+        size_t  dash    = range.find('-');
+        int     first   = std::stoi(range.substr(0, dash));
+        int     last    = dash == string::npos ? first : std::stoi(range.substr(dash + 1));
+
+        for (int cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+    }
+
+    return cpus;
+}
+
+std::vector<NumaNode> read_numa_topology()
+{
+    using std::string;
+    using std::vector;
+    using std::ifstream;
+
+    string const    node_path = "/sys/devices/system/node/";
+    vector<NumaNode> nodes;
+    string          online;
+
+    ifstream online_file(node_path + "online");
+
+    if (std::getline(online_file, online))
+    {
+        for (int id : parse_cpu_list(online))
+        {
+            ifstream    cpulist_file(node_path + "node" + std::to_string(id) + "/cpulist");
+            string      cpulist;
+
+            if (std::getline(cpulist_file, cpulist))
+            {
+                vector<int> cpus = parse_cpu_list(cpulist);
+                // memory-only nodes have no cpus to run workers on
+                if (not cpus.empty())
+                    nodes.push_back(NumaNode{id, cpus});
+            }
+        }
+    }
+
+    if (nodes.empty())
+    {
+        int ncpus = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        nodes.push_back(NumaNode{0, {}});
+        for (int cpu = 0; cpu < ncpus; ++cpu)
+            nodes[0].cpus.push_back(cpu);
+    }
+
+    return nodes;
+}
+
+std::vector<WorkerPlacement> place_workers(std::vector<NumaNode> const& nodes, int nthreads)
+{
+    assert( not nodes.empty() and nthreads > 0 );
+
+    std::vector<WorkerPlacement> placement;
+
+    int nnodes = static_cast<int>(nodes.size());
+
+    for (int w = 0; w < nthreads; ++w)
+    {
+
+        // worker w belongs to node w * nnodes / nthreads, cpus of a node are used round-robin
+        int         n           = static_cast<int>(static_cast<long>(w) * nnodes / nthreads);
+        int         first       = static_cast<int>((static_cast<long>(n) * nthreads + nnodes - 1) / nnodes);
+        auto const& node        = nodes[n];
+        int         local_index = (w - first) % static_cast<int>(node.cpus.size());
+
+        placement.push_back(WorkerPlacement{node.id, node.cpus[local_index]});
+
+    }
+
+    return placement;
+}
+
+bool pin_current_thread(int cpu)
+{
+    cpu_set_t cpu_set;
+
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) == 0;
+}
@@ -0,0 +1,34 @@
+#ifndef NUMA_H_
+#define NUMA_H_
+
+#include <string>
+#include <vector>
+
+// a NUMA node and the cpus attached to it
+struct NumaNode
+{
+    int                 id;
+    std::vector<int>    cpus;
+};
+
+// cpu a worker thread is pinned to and the node of that cpu
+struct WorkerPlacement
+{
+    int node;
+    int cpu;
+};
+
+// parse a cpu list in the kernel format, e.g. "0-3,8,10-11"
+std::vector<int> parse_cpu_list(std::string const& text);
+
+// read the node topology from /sys/devices/system/node,
+// without NUMA support all cpus are reported as a single node 0
+std::vector<NumaNode> read_numa_topology();
+
+// distribute nthreads workers evenly over the nodes, consecutive workers share a node
+std::vector<WorkerPlacement> place_workers(std::vector<NumaNode> const& nodes, int nthreads);
+
+// pin the calling thread to a cpu, returns false if this is not possible
+bool pin_current_thread(int cpu);
+
+#endif
@@ -0,0 +1,105 @@
+#include <cassert>
+
+#include "parallel_ffts.hpp"
+
+ThreadTeam::ThreadTeam(std::vector<WorkerPlacement> const& placement, bool pin_threads)
+    : current_job{nullptr}, generation{0}, running{0}, stop{false}
+{
+    assert( not placement.empty() );
+
+    for (int t = 0; t < static_cast<int>(placement.size()); ++t)
+        threads.emplace_back(&ThreadTeam::work, this, t, placement[t].cpu, pin_threads);
+}
+
+ThreadTeam::~ThreadTeam()
+{
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stop = true;
+    }
+    cv.notify_all();
+
+    for (auto& thread : threads)
+        thread.join();
+}
+
+void ThreadTeam::run(std::function<void(int)> const& job)
+{
+    std::lock_guard<std::mutex> run_lock(run_mutex);
+    std::unique_lock<std::mutex> lock(m);
+
+    current_job = &job;
+    running     = size();
+    error       = nullptr;
+    ++generation;
+    cv.notify_all();
+
+    cv.wait(lock, [this] { return running == 0; });
+
+    current_job = nullptr;
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void ThreadTeam::work(int t, int cpu, bool pin_thread)
+{
+    if (pin_thread)
+        pin_current_thread(cpu);
+
+    long seen = 0;
+
+    for (;;)
+    {
+        std::function<void(int)> const* job;
+
+        {
+            std::unique_lock<std::mutex> lock(m);
+
+            cv.wait(lock, [&] { return stop or generation != seen; });
+
+            if (stop)
+                return;
+
+            seen    = generation;
+            job     = current_job;
+        }
+
+        std::exception_ptr job_error;
+
+        try
+        {
+            (*job)(t);
+        }
+        catch (...)
+        {
+            job_error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(m);
+
+        if (job_error and not error)
+            error = job_error;
+
+        if (--running == 0)
+            cv.notify_all();
+    }
+}
+
+FourStepPlan make_four_step_plan(int size, int option, int threshold, int nthreads, bool pin_threads)
+{
+    assert( size > 0 and nthreads >= 0 );
+
+    int n1 = 1;
+    for (int d = 1; d * d <= size; ++d)
+        if (size % d == 0)
+            n1 = d;
+
+    int n2 = size / n1;
+
+    std::shared_ptr<ThreadTeam> team;
+    if (nthreads > 0)
+        team = std::make_shared<ThreadTeam>(place_workers(read_numa_topology(), nthreads), pin_threads);
+
+    return FourStepPlan{n1, n2, make_plan(n1, option, threshold), make_plan(n2, option, threshold), team};
+}
@@ -0,0 +1,319 @@
+#ifndef PARALLEL_FFTS_H_
+#define PARALLEL_FFTS_H_
+
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <complex>
+#include <cassert>
+#include <stdexcept>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#include "ffts.hpp"
+#include "numa.hpp"
+#include "WorkStealingPool.hpp"
+
+// Fixed team of worker threads that run the same job, job(t) for worker t. The workers are placed
+// on the NUMA nodes once and, if requested, pinned to their cpus when they start, so that neither
+// the topology is read nor threads are created for every job. Jobs of different callers are serialized.
+class ThreadTeam
+{
+public:
+    ThreadTeam(std::vector<WorkerPlacement> const& placement, bool pin_threads);
+
+    ThreadTeam(ThreadTeam const&) = delete;
+    ThreadTeam& operator=(ThreadTeam const&) = delete;
+
+    ~ThreadTeam();
+
+    int size() const
+    {
+        return static_cast<int>(threads.size());
+    };
+
+    // returns when all workers have finished the job, the first exception of a worker is rethrown
+    void run(std::function<void(int)> const& job);
+
+private:
+    std::mutex                          run_mutex;      // one job at a time
+    std::mutex                          m;
+    std::condition_variable             cv;
+    std::function<void(int)> const*     current_job;
+    long                                generation;
+    int                                 running;
+    bool                                stop;
+    std::exception_ptr                  error;
+    std::vector<std::thread>            threads;
+
+    void work(int t, int cpu, bool pin_thread);
+};
+
+// setup of a four-step transform of size n1 * n2 with the row transforms of both steps
+// and the workers of the parallel transform (none if the plan is only used for its split)
+struct FourStepPlan
+{
+    int                         n1;
+    int                         n2;
+    FftPlan                     plan1;
+    FftPlan                     plan2;
+    std::shared_ptr<ThreadTeam> team;
+};
+
+// split size into n1 * n2 with n1 the largest divisor not larger than sqrt(size),
+// with nthreads > 0 the plan holds a team of nthreads workers placed node by node
+FourStepPlan make_four_step_plan(int size, int option, int threshold, int nthreads = 0, bool pin_threads = false);
+
+// thrown by Barrier::wait after another thread has aborted the barrier
+class BarrierAborted : public std::runtime_error
+{
+public:
+    BarrierAborted() : std::runtime_error("barrier aborted") {};
+};
+
+// reusable barrier for a fixed number of threads, a thread that fails aborts it so that the others
+// do not wait forever for it: waiting and later calls of wait throw BarrierAborted
+class Barrier
+{
+public:
+    explicit Barrier(int count) : nthreads{count}, waiting{0}, generation{0}, aborted{false} {};
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m);
+
+        if (aborted)
+            throw BarrierAborted();
+
+        long current = generation;
+
+        if (++waiting == nthreads)
+        {
+            waiting = 0;
+            ++generation;
+            cv.notify_all();
+        }
+        else
+        {
+            cv.wait(lock, [&]{ return aborted or generation != current; });
+
+            if (generation == current)
+                throw BarrierAborted();
+        }
+    };
+
+    void abort()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            aborted = true;
+        }
+        cv.notify_all();
+    };
+
+private:
+    int const               nthreads;
+    int                     waiting;
+    long                    generation;
+    bool                    aborted;
+    std::mutex              m;
+    std::condition_variable cv;
+};
+
+// job(t, barrier) on every worker t of team with a barrier of all workers, a worker that throws
+// aborts the barrier, the others leave it and only the exception of the failed worker is rethrown
+template <typename Job>
+void run_with_barrier(ThreadTeam& team, Job const& job)
+{
+    Barrier barrier(team.size());
+
+    team.run([&](int t) {
+        try
+        {
+            job(t, barrier);
+        }
+        catch (BarrierAborted const&)
+        {
+        }
+        catch (...)
+        {
+            barrier.abort();
+            throw;
+        }
+    });
+}
+
+// first index of the part of [0, n) that belongs to thread t of nthreads
+inline int partition_begin(int n, int t, int nthreads)
+{
+    return static_cast<int>(static_cast<long>(n) * t / nthreads);
+}
+
+// Four-step FFT, x is interpreted as n1 x n2 matrix in row-major format:
+//   1. DFTs of length n1 of the columns, multiplied by the twiddle factors W_N^(c * k1)
+//   2. DFTs of length n2 of the rows of the result, output is transposed into x
+// Every worker owns a contiguous range of columns in step 1 and of rows in step 2.
+// Its slabs are allocated and first touched by the worker itself, so with pinning
+// they are placed on the node of the worker. Data crosses nodes only in the two
+// transposes, which copy contiguous chunks of a whole range at once.
+template <typename complex_t>
+void fft_four_step_parallel(FftBuffer<complex_t>& x, FourStepPlan const& plan)
+{
+    assert( static_cast<int>(x.size()) == plan.n1 * plan.n2 and plan.team != nullptr );
+
+    int const   n1          = plan.n1;
+    int const   n2          = plan.n2;
+    long const  size        = static_cast<long>(n1) * n2;
+    int const   nthreads    = plan.team->size();
+
+    std::vector<FftBuffer<complex_t>>   column_slabs(nthreads);
+
+    auto worker = [&](int t, Barrier& barrier)
+    {
+        FftBuffer<complex_t> work;
+
+        // step 1: gather the own columns c0 <= c < c1 as rows of the slab
+        int c0      = partition_begin(n2, t, nthreads);
+        int c1      = partition_begin(n2, t + 1, nthreads);
+        auto& slab  = column_slabs[t];
+
+        slab = FftBuffer<complex_t>(static_cast<size_t>(c1 - c0) * n1);
+
+        for (int r = 0; r < n1; ++r)
+            for (int c = c0; c < c1; ++c)
+                slab[static_cast<size_t>(c - c0) * n1 + r] = x[static_cast<size_t>(r) * n2 + c];
+
+        execute_batch(plan.plan1, slab.data(), c1 - c0, work);
+
+        for (int c = c0; c < c1; ++c)
+            for (int k1 = 0; k1 < n1; ++k1)
+                slab[static_cast<size_t>(c - c0) * n1 + k1] *= static_cast<complex_t>(std::polar(1.0L, -2 * PI / size * (static_cast<long>(c) * k1 % size)));
+
+        barrier.wait();
+
+        // step 2: pull the own rows k0 <= k1 < k1_end from the column slabs of all workers
+        int k0      = partition_begin(n1, t, nthreads);
+        int k1_end  = partition_begin(n1, t + 1, nthreads);
+
+        FftBuffer<complex_t> row_slab(static_cast<size_t>(k1_end - k0) * n2);
+
+        for (int s = 0; s < nthreads; ++s)
+        {
+            int     s_c0        = partition_begin(n2, s, nthreads);
+            auto&   remote_slab = column_slabs[s];
+
+            for (int c = s_c0; c < partition_begin(n2, s + 1, nthreads); ++c)
+                for (int k1 = k0; k1 < k1_end; ++k1)
+                    row_slab[static_cast<size_t>(k1 - k0) * n2 + c] = remote_slab[static_cast<size_t>(c - s_c0) * n1 + k1];
+        }
+
+        execute_batch(plan.plan2, row_slab.data(), k1_end - k0, work);
+
+        // all workers must have finished reading x before it is overwritten
+        barrier.wait();
+
+        // X[k1 + n1 * k2] is stored in row k1 and column k2 of the row slab
+        for (int k2 = 0; k2 < n2; ++k2)
+            for (int k1 = k0; k1 < k1_end; ++k1)
+                x[static_cast<size_t>(k2) * n1 + k1] = row_slab[static_cast<size_t>(k1 - k0) * n2 + k2];
+    };
+
+    // the calling thread only waits, so that it is never pinned
+    run_with_barrier(*plan.team, worker);
+}
+
+// depth-first FFT: the column sub-transforms of every level are spawned as tasks
+// until a column has at most grain elements, then it is solved sequentially
+template <typename complex_t>
+void solve_dft_recursive_tasks(StridedVector<complex_t>& in, std::vector<int> radices, WorkStealingPool& pool, int grain)
+{
+    int size = static_cast<int>(in.size());
+
+    if (radices.size() == 1 or size <= grain)
+    {
+        solve_dft_recursive(in, radices);
+        return;
+    }
+
+    int radix   = radices.back();
+    int rest    = size / radix;
+
+    radices.pop_back();
+
+    std::vector<StridedVector<complex_t>> columns;
+    for (int l = 0; l < radix; ++l)
+        columns.emplace_back(in, radix, l, rest);
+
+    TaskGroup group(pool);
+    for (int l = 0; l < radix; ++l)
+        group.spawn([&, l]{ solve_dft_recursive_tasks(columns[l], radices, pool, grain); });
+    group.wait();
+
+    // the rows of the butterfly are independent, chunks of about grain elements become tasks
+    FftBuffer<complex_t> buffer(size, 0.0);
+
+    parallel_for(pool, 0, rest, std::max(1, grain / radix), [&](int k0_begin, int k0_end) {
+        butterfly_recursive(columns, k0_begin, k0_end, buffer);
+    });
+
+    for (int k = 0; k < size; ++k)
+        in[k] = buffer[k];
+}
+
+// Cooley-Tuckey type implementation of the DFT by decimation in time, depth-first, mixed-radix,
+// parallelized by the work-stealing pool
+template <typename complex_t>
+FftBuffer<complex_t> fft_recursive_depth_first_tasks(FftBuffer<complex_t>& x, std::vector<int>& radices, WorkStealingPool& pool, int grain)
+{
+    assert( std::accumulate(radices.begin(), radices.end(), 1, std::multiplies<int>()) == static_cast<int>(x.size()) );
+
+    StridedVector<complex_t> strided_in{x};
+
+    pool.run([&]{ solve_dft_recursive_tasks(strided_in, radices, pool, grain); });
+
+    return x;
+}
+
+// reference for the work-stealing version: the columns and the butterfly rows of the
+// top level are split statically among the OpenMP threads, the columns are solved sequentially
+template <typename complex_t>
+FftBuffer<complex_t> fft_recursive_depth_first_omp(FftBuffer<complex_t>& x, std::vector<int>& radices, int nthreads)
+{
+    assert( std::accumulate(radices.begin(), radices.end(), 1, std::multiplies<int>()) == static_cast<int>(x.size()) );
+
+    StridedVector<complex_t> in{x};
+
+    if (radices.size() == 1)
+    {
+        solve_dft_recursive(in, radices);
+        return x;
+    }
+
+    int                 size            = static_cast<int>(x.size());
+    int                 radix           = radices.back();
+    int                 rest            = size / radix;
+    std::vector<int>    column_radices(radices.begin(), radices.end() - 1);
+
+    std::vector<StridedVector<complex_t>> columns;
+    for (int l = 0; l < radix; ++l)
+        columns.emplace_back(in, radix, l, rest);
+
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+    for (int l = 0; l < radix; ++l)
+        solve_dft_recursive(columns[l], column_radices);
+
+    FftBuffer<complex_t> buffer(size, 0.0);
+
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+    for (int t = 0; t < nthreads; ++t)
+        butterfly_recursive(columns, partition_begin(rest, t, nthreads), partition_begin(rest, t + 1, nthreads), buffer);
+
+    for (int k = 0; k < size; ++k)
+        x[k] = buffer[k];
+
+    return x;
+}
+
+#endif
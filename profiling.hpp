@@ -0,0 +1,191 @@
+#ifndef PROFILING_H_
+#define PROFILING_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <fstream>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/resource.h>
+
+// Resource measurements of transforms on Linux: peak resident set size, RAPL package energy and
+// a model of the data each stage of an engine works on, to be compared with the sizes of the caches.
+
+// peak resident set size of the process in kB (VmHWM, the maximum RSS of getrusage if /proc is not available)
+inline long peak_rss_kb()
+{
+    std::ifstream   status("/proc/self/status");
+    std::string     line;
+
+    while (std::getline(status, line))
+        if (line.compare(0, 6, "VmHWM:") == 0)
+            return std::stol(line.substr(6));
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_maxrss;
+}
+
+// resets the peak to the current resident set size, false if the kernel does not support it
+// (then peak_rss_kb is the peak of the whole process lifetime)
+inline bool reset_peak_rss()
+{
+    std::ofstream clear_refs("/proc/self/clear_refs");
+
+    clear_refs << "5" << std::flush;
+
+    return clear_refs.good();
+}
+
+// energy consumed by all processor packages since construction, read from the RAPL counters of the
+// powercap interface (/sys/class/powercap/intel-rapl:<package>, also used for AMD processors), which
+// are usually readable by root only. The counters wrap around after max_energy_range_uj, joules() must
+// be called at least once per wrap-around (minutes at full load) to account for it.
+class EnergyCounter
+{
+public:
+    EnergyCounter()
+    {
+        for (int package = 0; ; ++package)
+        {
+            std::string     path = "/sys/class/powercap/intel-rapl:" + std::to_string(package) + "/";
+            std::ifstream   name(path + "name");
+            std::string     domain;
+
+            if (not (name >> domain))
+                break;
+
+            Domain d{path + "energy_uj", 0, 0};
+
+            std::ifstream range(path + "max_energy_range_uj");
+
+            if (domain.compare(0, 7, "package") == 0 and range >> d.range and read(d.file, d.last))
+                domains.push_back(d);
+        }
+    };
+
+    bool available() const
+    {
+        return not domains.empty();
+    };
+
+    double joules()
+    {
+        for (auto& d : domains)
+        {
+            unsigned long long value;
+
+            if (not read(d.file, value))
+                continue;
+
+            accumulated += value >= d.last ? value - d.last : value + d.range - d.last;
+            d.last       = value;
+        }
+
+        return static_cast<double>(accumulated) * 1e-6;
+    };
+
+private:
+    struct Domain
+    {
+        std::string         file;
+        unsigned long long  range;
+        unsigned long long  last;
+    };
+
+    std::vector<Domain>     domains;
+    unsigned long long      accumulated = 0;    // microjoules
+
+    static bool read(std::string const& file, unsigned long long& value)
+    {
+        std::ifstream in(file);
+
+        return static_cast<bool>(in >> value);
+    };
+};
+
+// smallest data cache holding bytes, "mem" if none does
+inline char const* cache_level(size_t bytes)
+{
+    static long const sizes[] = {sysconf(_SC_LEVEL1_DCACHE_SIZE), sysconf(_SC_LEVEL2_CACHE_SIZE), sysconf(_SC_LEVEL3_CACHE_SIZE)};
+    static char const* const names[] = {"L1", "L2", "L3"};
+
+    for (int i = 0; i < 3; ++i)
+        if (sizes[i] > 0 and bytes <= static_cast<size_t>(sizes[i]))
+            return names[i];
+
+    return "mem";
+}
+
+// Estimated cache footprints of the stages of the engines in bytes: the data a stage works on before it
+// moves on to data it has not touched, with strided elements counted as whole cache lines.
+
+// fft_iterative_breadth_first: every stage sweeps the whole working buffer, the first also reads the input
+inline std::vector<size_t> breadth_first_footprints(std::vector<int> const& radices, size_t element_size)
+{
+    size_t n = element_size;
+    for (int radix : radices)
+        n *= static_cast<size_t>(radix);
+
+    std::vector<size_t> footprints(radices.size(), n);
+    footprints[0] += n;
+
+    return footprints;
+}
+
+// fft_recursive_depth_first: stage d transforms subproblems of the product of the first radices.size() - d
+// radices, elements at the stride of the other radices, and copies each through a buffer of its size
+inline std::vector<size_t> depth_first_footprints(std::vector<int> const& radices, size_t element_size, size_t line_size)
+{
+    std::vector<size_t> footprints;
+    size_t              stride  = 1;
+    size_t              size    = 1;
+
+    for (int radix : radices)
+        size *= static_cast<size_t>(radix);
+
+    for (auto radix = radices.rbegin(); radix != radices.rend(); ++radix)
+    {
+        footprints.push_back(size * (std::min(stride * element_size, std::max(line_size, element_size)) + element_size));
+
+        size    /= static_cast<size_t>(*radix);
+        stride  *= static_cast<size_t>(*radix);
+    }
+
+    return footprints;
+}
+
+// fft_split_radix: level d writes subproblems of size / 2^d contiguous elements from inputs at stride 2^d
+// and reads a quarter of the twiddle table of the size, a transform of size 4 is a single codelet
+inline std::vector<size_t> split_radix_footprints(int size, size_t element_size, size_t line_size)
+{
+    std::vector<size_t> footprints;
+    size_t              twiddles = static_cast<size_t>(size) / 4 * 16;
+
+    for (size_t stride = 1, m = static_cast<size_t>(size); m > 1 and not (m == 2 and size == 4); m /= 2, stride *= 2)
+        footprints.push_back(m * (std::min(stride * element_size, std::max(line_size, element_size)) + element_size) + twiddles / stride);
+
+    return footprints;
+}
+
+// fft_four_step_parallel, for one of nthreads workers: the gather of its columns of x into its slab, the
+// column transforms of size n1, the twiddle factors, the transpose of its rows out of all slabs, the row
+// transforms of size n2 and the scatter into x; the transforms are breadth-first with a work buffer
+inline std::vector<size_t> four_step_footprints(int n1, int n2, int nthreads, size_t element_size, size_t line_size)
+{
+    size_t const columns        = static_cast<size_t>((n2 + nthreads - 1) / nthreads);
+    size_t const rows           = static_cast<size_t>((n1 + nthreads - 1) / nthreads);
+    size_t const column_slab    = columns * static_cast<size_t>(n1) * element_size;
+    size_t const row_slab       = rows * static_cast<size_t>(n2) * element_size;
+
+    return {column_slab + static_cast<size_t>(n1) * std::max(line_size, columns * element_size),
+            2 * static_cast<size_t>(n1) * element_size,
+            column_slab,
+            row_slab + static_cast<size_t>(n2) * std::max(line_size, rows * element_size),
+            2 * static_cast<size_t>(n2) * element_size,
+            row_slab + static_cast<size_t>(n2) * std::max(line_size, rows * element_size)};
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include <cmath>
+#include <cassert>
+
+#include "pruned_ffts.hpp"
+
+namespace
+{
+
+// smallest divisor of size that is not smaller than lower
+int smallest_divisor_at_least(int size, int lower)
+{
+    for (int d = std::max(1, lower); d < size; ++d)
+        if (size % d == 0)
+            return d;
+
+    return size;
+}
+
+// operations of the transforms of count blocks of the given size in units of a Goertzel step,
+// a butterfly operation of the mixed-radix kernels costs about five of them
+double fft_cost(int size, int count)
+{
+    return 5.0 * count * size * std::max(1.0, std::log2(static_cast<double>(size)));
+}
+
+}
+
+PrunedPlan make_pruned_plan(int size, int nonzero_inputs, int first_bin, int last_bin, int option, int threshold)
+{
+    assert( size > 0 and 0 < nonzero_inputs and nonzero_inputs <= size );
+    assert( 0 <= first_bin and first_bin < last_bin and last_bin <= size );
+
+    int     nbins       = last_bin - first_bin;
+
+    PruningMode mode    = PruningMode::full;
+    int     sub_size    = size;
+    double  best        = fft_cost(size, 1);
+
+    // the input-pruned transform computes the residues that contain requested bins
+    int     input_size  = smallest_divisor_at_least(size, nonzero_inputs);
+    int     input_subs  = std::min(size / input_size, nbins);
+    double  input_cost  = fft_cost(input_size, input_subs) + static_cast<double>(input_subs) * nonzero_inputs;
+
+    if (input_size < size and input_cost < best)
+    {
+        mode        = PruningMode::input;
+        sub_size    = input_size;
+        best        = input_cost;
+    }
+
+    int     output_size     = smallest_divisor_at_least(size, nbins);
+    int     output_subs     = std::min(size / output_size, nonzero_inputs);
+    double  output_cost     = fft_cost(output_size, output_subs) + static_cast<double>(output_subs) * nbins;
+
+    if (output_size < size and output_cost < best)
+    {
+        mode        = PruningMode::output;
+        sub_size    = output_size;
+        best        = output_cost;
+    }
+
+    // a few bins are cheaper by direct recurrences
+    double  goertzel_cost   = static_cast<double>(nbins) * nonzero_inputs;
+
+    if (goertzel_cost < best)
+    {
+        mode        = PruningMode::goertzel;
+        sub_size    = 1;
+    }
+
+    PrunedPlan plan{size, nonzero_inputs, first_bin, last_bin, mode, sub_size, make_plan(sub_size, option, threshold), {}};
+
+    if (mode != PruningMode::goertzel)
+    {
+        plan.twiddles.resize(size);
+        for (int j = 0; j < size; ++j)
+            plan.twiddles[j] = static_cast<std::complex<double>>(std::polar(1.0L, -2 * PI / size * j));
+    }
+
+    return plan;
+}
+
+char const* pruning_mode_name(PruningMode mode)
+{
+    switch (mode)
+    {
+    case PruningMode::full:
+        return "full";
+    case PruningMode::input:
+        return "input";
+    case PruningMode::output:
+        return "output";
+    case PruningMode::goertzel:
+        return "goertzel";
+    }
+
+    return "";
+}
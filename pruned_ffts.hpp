@@ -0,0 +1,165 @@
+#ifndef PRUNED_FFTS_H_
+#define PRUNED_FFTS_H_
+
+#include <vector>
+#include <complex>
+#include <cassert>
+#include <algorithm>
+
+#include "ffts.hpp"
+
+// way in which a pruned transform is computed
+enum class PruningMode
+{
+    full,       // zero-padded full transform, the requested bins are copied out
+    input,      // sub-transforms of the nonzero input prefix, one per residue of the bins
+    output,     // sub-transforms of the decimated inputs combined only for the requested bins
+    goertzel    // one second-order recurrence per bin
+};
+
+// Setup of a forward transform of size elements of which only the first nonzero_inputs
+// can be nonzero and only the bins first_bin <= k < last_bin are computed.
+// The input-pruned mode splits size = sub_size * (size / sub_size) with sub_size >= nonzero_inputs:
+//     X[L k2 + k1] = DFT_M(x[n] W_N^(n k1))[k2],
+// the output-pruned mode shifts the bins to 0 <= k < K by modulation and splits with sub_size >= K:
+//     X[a + k] = sum_n1 W_N^(n1 k) DFT_M(x[L n2 + n1] W_N^((L n2 + n1) a))[k mod M].
+struct PrunedPlan
+{
+    int                                 size;
+    int                                 nonzero_inputs;
+    int                                 first_bin;
+    int                                 last_bin;
+    PruningMode                         mode;
+    int                                 sub_size;
+    FftPlan                             sub_plan;
+    std::vector<std::complex<double>>   twiddles;   // W_N^j for 0 <= j < size, not used by the Goertzel mode
+};
+
+// choose the mode with the least estimated number of operations
+PrunedPlan make_pruned_plan(int size, int nonzero_inputs, int first_bin, int last_bin, int option, int threshold);
+
+char const* pruning_mode_name(PruningMode mode);
+
+// Goertzel recurrence for bin k of the input prefix in[0, m), accumulated in double precision
+template <typename complex_t>
+complex_t goertzel(complex_t const* in, int m, int size, int k)
+{
+    long double omega   = 2 * PI / size * k;
+    double      coeff   = static_cast<double>(2 * std::cos(omega));
+
+    std::complex<double> s1 = 0.0;
+    std::complex<double> s2 = 0.0;
+
+    for (int n = 0; n < m; ++n)
+    {
+        std::complex<double> s0 = std::complex<double>(in[n]) + coeff * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+
+    // X[k] = exp(-i omega (m - 1)) (s[m - 1] - exp(-i omega) s[m - 2])
+    std::complex<double> y = s1 - std::complex<double>(std::polar(1.0L, -omega)) * s2;
+
+    return static_cast<complex_t>(std::complex<double>(std::polar(1.0L, -omega * (m - 1))) * y);
+}
+
+// bins [first_bin, last_bin) of the transform of in[0, nonzero_inputs) padded to plan.size,
+// out holds last_bin - first_bin elements, the work vectors are resized if necessary
+template <typename complex_t>
+void fft_pruned(PrunedPlan const& plan, complex_t const* in, complex_t* out, FftBuffer<complex_t>& work, FftBuffer<complex_t>& columns)
+{
+    int size    = plan.size;
+    int m       = plan.nonzero_inputs;
+    int a       = plan.first_bin;
+    int b       = plan.last_bin;
+
+    auto twiddle = [&](long long j) { return static_cast<complex_t>(plan.twiddles[j % size]); };
+
+    switch (plan.mode)
+    {
+    case PruningMode::full:
+    {
+        work.assign(size, 0.0);
+        std::copy(in, in + m, work.begin());
+
+        fft_iterative_breadth_first(work, plan.sub_plan.radices);
+
+        std::copy(work.begin() + a, work.begin() + b, out);
+        break;
+    }
+    case PruningMode::input:
+    {
+        int sub_size    = plan.sub_size;
+        int nsubs       = size / sub_size;
+
+        work.resize(sub_size);
+
+        for (int k1 = 0; k1 < nsubs; ++k1)
+        {
+
+            // first bin L k2 + k1 >= a of this residue, skip the residue if it has none below b
+            int k2_begin = std::max(0, (a - k1 + nsubs - 1) / nsubs);
+            if (static_cast<long long>(k2_begin) * nsubs + k1 >= b)
+                continue;
+
+            for (int n = 0; n < m; ++n)
+                work[n] = in[n] * twiddle(static_cast<long long>(n) * k1);
+            std::fill(work.begin() + m, work.end(), 0.0);
+
+            fft_iterative_breadth_first(work, plan.sub_plan.radices);
+
+            for (int k2 = k2_begin; k2 * nsubs + k1 < b; ++k2)
+                out[k2 * nsubs + k1 - a] = work[k2];
+
+        }
+        break;
+    }
+    case PruningMode::output:
+    {
+        int sub_size    = plan.sub_size;
+        int nsubs       = size / sub_size;
+        int nbins       = b - a;
+        // decimated sequences n1 >= m only contain zeros
+        int nactive     = std::min(nsubs, m);
+
+        work.resize(sub_size);
+        columns.resize(static_cast<size_t>(nactive) * sub_size);
+
+        for (int n1 = 0; n1 < nactive; ++n1)
+        {
+
+            for (int n2 = 0; n2 < sub_size; ++n2)
+            {
+                long long n = static_cast<long long>(n2) * nsubs + n1;
+                work[n2] = n < m ? in[n] * twiddle(n * a) : complex_t(0.0);
+            }
+
+            fft_iterative_breadth_first(work, plan.sub_plan.radices);
+
+            std::copy(work.begin(), work.end(), columns.begin() + static_cast<ptrdiff_t>(n1) * sub_size);
+
+        }
+
+        for (int k = 0; k < nbins; ++k)
+        {
+
+            complex_t y = 0.0;
+
+            for (int n1 = 0; n1 < nactive; ++n1)
+                y += twiddle(static_cast<long long>(n1) * k) * columns[static_cast<size_t>(n1) * sub_size + k % sub_size];
+
+            out[k] = y;
+
+        }
+        break;
+    }
+    case PruningMode::goertzel:
+    {
+        for (int k = a; k < b; ++k)
+            out[k - a] = goertzel(in, m, size, k);
+        break;
+    }
+    }
+}
+
+#endif
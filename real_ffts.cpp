@@ -0,0 +1,13 @@
+#include <cassert>
+
+#include "real_ffts.hpp"
+
+RealFftPlan make_real_plan(int size, int option, int threshold)
+{
+    assert( size > 0 );
+
+    if (size % 2 != 0)
+        return RealFftPlan{size, make_plan(size, option, threshold), {}};
+
+    return RealFftPlan{size, make_plan(size / 2, option, threshold), shared_twiddles(size, size / 2 + 1)};
+}
@@ -0,0 +1,134 @@
+#ifndef REAL_FFTS_H_
+#define REAL_FFTS_H_
+
+#include <vector>
+#include <complex>
+#include <cassert>
+
+#include "ffts.hpp"
+
+// Setup of a transform of size real values. For even sizes the values are packed pairwise
+// into a complex transform of half the size, the spectrum of the even and odd elements is
+// separated afterwards, X[k] = E[k] + W_N^k O[k]. Odd sizes use a complex transform of the full size.
+struct RealFftPlan
+{
+    int                                 size;
+    FftPlan                             complex_plan;
+    TwiddleView                         twiddles;   // W_N^k for 0 <= k <= size / 2 (even sizes)
+};
+
+RealFftPlan make_real_plan(int size, int option, int threshold);
+
+// Forward transform of the real sequence load(n), 0 <= n < size, store(k, X[k]) receives the bins
+// 0 <= k <= size / 2, the others are their conjugates. The functors allow the callers to fuse
+// their reordering and post-processing passes into the packing and separation steps.
+template <typename real_t, typename Load, typename Store>
+void fft_r2c_fused(RealFftPlan const& plan, Load const& load, Store const& store, FftBuffer<std::complex<real_t>>& work)
+{
+    using complex_t = std::complex<real_t>;
+
+    int size = plan.size;
+
+    if (size % 2 != 0)
+    {
+        work.resize(size);
+        for (int n = 0; n < size; ++n)
+            work[n] = complex_t(load(n), 0.0);
+
+        fft_iterative_breadth_first(work, plan.complex_plan.radices);
+
+        for (int k = 0; k <= size / 2; ++k)
+            store(k, work[k]);
+
+        return;
+    }
+
+    int half = size / 2;
+
+    work.resize(half);
+    for (int n = 0; n < half; ++n)
+        work[n] = complex_t(load(2 * n), load(2 * n + 1));
+
+    fft_iterative_breadth_first(work, plan.complex_plan.radices);
+
+    for (int k = 0; k <= half; ++k)
+    {
+
+        complex_t z     = work[k % half];
+        complex_t zc    = std::conj(work[(half - k) % half]);
+        complex_t even  = real_t(0.5) * (z + zc);
+        complex_t odd   = complex_t(0.0, -0.5) * (z - zc);
+
+        store(k, even + static_cast<complex_t>(plan.twiddles[k]) * odd);
+
+    }
+}
+
+// Unnormalized backward transform of the hermitian spectrum load(k), 0 <= k <= size / 2,
+// store(n, x[n]) receives the real values 0 <= n < size.
+template <typename real_t, typename Load, typename Store>
+void fft_c2r_fused(RealFftPlan const& plan, Load const& load, Store const& store, FftBuffer<std::complex<real_t>>& work)
+{
+    using complex_t = std::complex<real_t>;
+
+    int size = plan.size;
+
+    // the backward transform is computed as the conjugate of the forward transform of the conjugate
+    if (size % 2 != 0)
+    {
+        work.resize(size);
+        for (int k = 0; k <= size / 2; ++k)
+        {
+            complex_t x = load(k);
+            work[k] = std::conj(x);
+            if (k > 0)
+                work[size - k] = x;
+        }
+
+        fft_iterative_breadth_first(work, plan.complex_plan.radices);
+
+        for (int n = 0; n < size; ++n)
+            store(n, work[n].real());
+
+        return;
+    }
+
+    int half = size / 2;
+
+    work.resize(half);
+    for (int k = 0; k < half; ++k)
+    {
+
+        complex_t x     = load(k);
+        complex_t xc    = std::conj(load(half - k));
+        complex_t even  = x + xc;
+        complex_t odd   = (x - xc) * std::conj(static_cast<complex_t>(plan.twiddles[k]));
+
+        work[k] = std::conj(even + complex_t(0.0, 1.0) * odd);
+
+    }
+
+    fft_iterative_breadth_first(work, plan.complex_plan.radices);
+
+    for (int n = 0; n < half; ++n)
+    {
+        store(2 * n, work[n].real());
+        store(2 * n + 1, -work[n].imag());
+    }
+}
+
+// out holds the bins 0 <= k <= size / 2
+template <typename real_t>
+void fft_r2c(RealFftPlan const& plan, real_t const* in, std::complex<real_t>* out, FftBuffer<std::complex<real_t>>& work)
+{
+    fft_r2c_fused<real_t>(plan, [&](int n) { return in[n]; }, [&](int k, std::complex<real_t> const& x) { out[k] = x; }, work);
+}
+
+// in holds the bins 0 <= k <= size / 2, the result is scaled by size
+template <typename real_t>
+void fft_c2r(RealFftPlan const& plan, std::complex<real_t> const* in, real_t* out, FftBuffer<std::complex<real_t>>& work)
+{
+    fft_c2r_fused<real_t>(plan, [&](int k) { return in[k]; }, [&](int n, real_t x) { out[n] = x; }, work);
+}
+
+#endif
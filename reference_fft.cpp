@@ -0,0 +1,121 @@
+#include <cmath>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+#include "reference_fft.hpp"
+
+namespace
+{
+
+using complex_ld = std::complex<long double>;
+
+// exp(direction 2 pi i k / n) with k reduced to |k| <= n / 2
+complex_ld root_of_unity(long long k, long long n, int direction)
+{
+    k %= n;
+    if (k < 0)
+        k += n;
+    if (2 * k > n)
+        k -= n;
+
+    return std::polar(1.0L, direction * 2 * PI * static_cast<long double>(k) / static_cast<long double>(n));
+}
+
+int smallest_prime_factor(int n)
+{
+    for (int p = 2; p * p <= n; ++p)
+        if (n % p == 0)
+            return p;
+
+    return n;
+}
+
+void transform(complex_ld const* in, ptrdiff_t stride, int n, complex_ld* out, int direction);
+
+// prime n by X[k] = c[k] sum_j x[j] c[j] conj(c[k - j]) with the chirp c[j] = exp(direction pi i j^2 / n)
+void transform_bluestein(complex_ld const* in, ptrdiff_t stride, int n, complex_ld* out, int direction)
+{
+    int m = 1;
+    while (m < 2 * n - 1)
+        m *= 2;
+
+    std::vector<complex_ld> chirp(n);
+    for (int j = 0; j < n; ++j)
+        chirp[j] = root_of_unity(static_cast<long long>(j) * j, 2LL * n, direction);
+
+    std::vector<complex_ld> a(m, 0.0L), b(m, 0.0L), fa(m), fb(m);
+    for (int j = 0; j < n; ++j)
+        a[j] = in[j * stride] * chirp[j];
+    b[0] = 1.0L;
+    for (int j = 1; j < n; ++j)
+        b[j] = b[m - j] = std::conj(chirp[j]);
+
+    transform(a.data(), 1, m, fa.data(), FFT_FORWARD);
+    transform(b.data(), 1, m, fb.data(), FFT_FORWARD);
+
+    for (int j = 0; j < m; ++j)
+        fa[j] *= fb[j];
+
+    transform(fa.data(), 1, m, a.data(), FFT_BACKWARD);
+
+    for (int k = 0; k < n; ++k)
+        out[k] = chirp[k] * a[k] / static_cast<long double>(m);
+}
+
+// decimation in time over the smallest prime factor p of n
+void transform(complex_ld const* in, ptrdiff_t stride, int n, complex_ld* out, int direction)
+{
+    int p = smallest_prime_factor(n);
+
+    if (p == n and n > 16)
+    {
+        transform_bluestein(in, stride, n, out, direction);
+        return;
+    }
+
+    std::vector<complex_ld> roots(n);
+    for (int j = 0; j < n; ++j)
+        roots[j] = root_of_unity(j, n, direction);
+
+    if (p == n)
+    {
+        for (int k = 0; k < n; ++k)
+        {
+            complex_ld y = 0.0L;
+            for (int j = 0; j < n; ++j)
+                y += in[j * stride] * roots[static_cast<long long>(j) * k % n];
+            out[k] = y;
+        }
+        return;
+    }
+
+    // transforms of the p interleaved subsequences of length m
+    int                     m = n / p;
+    std::vector<complex_ld> sub(n);
+
+    for (int r = 0; r < p; ++r)
+        transform(in + r * stride, stride * p, m, sub.data() + static_cast<ptrdiff_t>(r) * m, direction);
+
+    for (int k = 0; k < n; ++k)
+    {
+        complex_ld y = 0.0L;
+        for (int r = 0; r < p; ++r)
+            y += sub[static_cast<ptrdiff_t>(r) * m + k % m] * roots[static_cast<long long>(r) * k % n];
+        out[k] = y;
+    }
+}
+
+}
+
+FftBuffer<std::complex<long double>> reference_fft(FftBuffer<std::complex<long double>> const& x, int direction)
+{
+    assert( not x.empty() );
+    assert( direction == FFT_FORWARD or direction == FFT_BACKWARD );
+
+    FftBuffer<std::complex<long double>> y(x.size());
+
+    transform(x.data(), 1, static_cast<int>(x.size()), y.data(), direction);
+
+    return y;
+}
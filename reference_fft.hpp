@@ -0,0 +1,15 @@
+#ifndef REFERENCE_FFT_H_
+#define REFERENCE_FFT_H_
+
+#include <complex>
+
+#include "ffts.hpp"
+
+// Reference transform X[k] = sum_n x[n] exp(direction 2 pi i n k / N) in long double precision for
+// accuracy tests. Every root of unity is evaluated directly from the reduced argument instead of a
+// recurrence, the transform recurses over the smallest prime factor and computes prime lengths above
+// 16 by Bluestein's algorithm with a power-of-two convolution, so that it takes O(N log N) operations
+// for all sizes whose prime factors are small or occur once, with a relative error of O(eps log N).
+FftBuffer<std::complex<long double>> reference_fft(FftBuffer<std::complex<long double>> const& x, int direction = FFT_FORWARD);
+
+#endif
@@ -1,7 +1,7 @@
-ALGORITHM=(1 3)
+ALGORITHM=(8 8 1 7 3)
 RADIXALGORITHM=3
-RADIXTHRESHOLD=16
-TEXT=("iterative" "FFTW")
+RADIXTHRESHOLD=(4 8 16 16 16)
+TEXT=("iterative, shared twiddles, radix 4" "iterative, shared twiddles, radix 8" "iterative" "split-radix" "FFTW")
 GNUPLOTSCRIPT=" set title 'Performance: Powers-of-2';
                 set title font 'Helvetica,14';
                 set xlabel 'Input Length';
@@ -19,13 +19,16 @@ GNUPLOTSCRIPT=" set title 'Performance: Powers-of-2';
                 set style line 4 \
                 linetype 4 linewidth 1 \
                 pointtype 1 pointsize 1.5;
+                set style line 5 \
+                linetype 5 linewidth 1 \
+                pointtype 1 pointsize 1.5;
                 set logscale x 2;
                 set logscale y 2;
                 plot"
 
-for i in 0 1
+for i in 0 1 2 3 4
 do
-    ../testit -a ${ALGORITHM[$i]} -g $RADIXALGORITHM -r $RADIXTHRESHOLD -p ${TEXT[$i]} |
+    ../testit -a ${ALGORITHM[$i]} -g $RADIXALGORITHM -r ${RADIXTHRESHOLD[$i]} -p "${TEXT[$i]}" |
     awk 'BEGIN{OFS=" "}
          NR > 2 {print $1,$4}' > "${TEXT[$i]}"
     GNUPLOTSCRIPT="${GNUPLOTSCRIPT} '${TEXT[$i]}' title '${TEXT[$i]}' with linespoints linestyle $((i+1)),"
@@ -0,0 +1,42 @@
+BLOCKSIZES=(256 1024 4096 16384)
+MODES=("-q" "-w 1" "-w 2" "-w 4")
+TEXT=("sequential" "pipelined, 1 worker" "pipelined, 2 workers" "pipelined, 4 workers")
+INPUT="pipeline_input.iq"
+OUTPUT="pipeline_output.iq"
+GNUPLOTSCRIPT=" set title 'Batch Pipeline: 64 MB of IQ samples';
+                set title font 'Helvetica,14';
+                set xlabel 'Block Length';
+                set ylabel 'Throughput [MB/s]';
+                set key left top;
+                set style line 1 \
+                linetype 1 linewidth 1 \
+                pointtype 7 pointsize 1.5;
+                set style line 2 \
+                linetype 2 linewidth 1 \
+                pointtype 1 pointsize 1.5;
+                set style line 3 \
+                linetype 3 linewidth 1 \
+                pointtype 1 pointsize 1.5;
+                set style line 4 \
+                linetype 4 linewidth 1 \
+                pointtype 1 pointsize 1.5;
+                set logscale x 2;
+                plot"
+
+head -c 64000000 /dev/zero > "$INPUT"
+
+for i in 0 1 2 3
+do
+    rm -f "${TEXT[$i]}"
+    for n in ${BLOCKSIZES[@]}
+    do
+        ../fftbatch -n $n -g 1 ${MODES[$i]} "$INPUT" "$OUTPUT" |
+        awk 'BEGIN{OFS=" "}
+             NR > 1 {print $2,$4}' >> "${TEXT[$i]}"
+    done
+    GNUPLOTSCRIPT="${GNUPLOTSCRIPT} '${TEXT[$i]}' title '${TEXT[$i]}' with linespoints linestyle $((i+1)),"
+done
+
+rm -f "$INPUT" "$OUTPUT"
+
+gnuplot -p -e "$GNUPLOTSCRIPT"
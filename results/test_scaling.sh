@@ -0,0 +1,27 @@
+ALGORITHM=(5 6)
+RADIXALGORITHM=1
+THREADS=16
+TEXT=("recursive, work-stealing" "recursive, OpenMP static")
+GNUPLOTSCRIPT=" set title 'Parallel Efficiency: 3*5*11*13 (2145)';
+                set title font 'Helvetica,14';
+                set xlabel 'Threads';
+                set ylabel 'Efficiency';
+                set key right top;
+                set style line 1 \
+                linetype 1 linewidth 1 \
+                pointtype 7 pointsize 1.5;
+                set style line 2 \
+                linetype 2 linewidth 1 \
+                pointtype 1 pointsize 1.5;
+                set logscale x 2;
+                plot"
+
+for i in 0 1
+do
+    ../testit -a ${ALGORITHM[$i]} -g $RADIXALGORITHM -t 3 -n -T $THREADS -P -p "${TEXT[$i]}" |
+    awk 'BEGIN{OFS=" "}
+         NR > 3 && $1 == 2145 {print $2,$6}' > "${TEXT[$i]}, scaling"
+    GNUPLOTSCRIPT="${GNUPLOTSCRIPT} '${TEXT[$i]}, scaling' title '${TEXT[$i]}' with linespoints linestyle $((i+1)),"
+done
+
+gnuplot -p -e "$GNUPLOTSCRIPT"
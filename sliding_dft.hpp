@@ -0,0 +1,143 @@
+#ifndef SLIDING_DFT_H_
+#define SLIDING_DFT_H_
+
+#include <cmath>
+#include <vector>
+#include <complex>
+#include <cassert>
+#include <algorithm>
+
+#include "ffts.hpp"
+#include "pruned_ffts.hpp"
+
+// Spectrum of the last size samples of a stream, reported every hop samples, either for all bins
+// or for a set of tracked bins. Two ways of computing it are chosen from by their operation count:
+//     sliding     every sample updates each bin, X_k <- W_N^(-k) (X_k - x[t - N] + x[t]),
+//                 which costs O(1) per bin and sample; rounding errors accumulate in the recurrence,
+//                 so the bins are recomputed from the window every reanchor_interval samples,
+//     hopping     every hop samples the bins are computed from the window by a full transform
+//                 or, for a few tracked bins, by Goertzel recurrences.
+// The samples before the first one are zero.
+template <typename complex_t>
+class SlidingDft
+{
+public:
+    SlidingDft(int size, int hop, std::vector<int> tracked_bins, int option, int threshold, int reanchor_interval = 0)
+        : window_size{size}, hop_size{hop}, bins{std::move(tracked_bins)}, plan{make_plan(size, option, threshold)},
+          interval{reanchor_interval > 0 ? reanchor_interval : size}, head{0}, since_hop{0}, since_anchor{0},
+          window(size, 0.0), work{}
+    {
+        assert( size > 0 and hop > 0 );
+
+        all_bins = bins.empty();
+        if (all_bins)
+            for (int k = 0; k < size; ++k)
+                bins.push_back(k);
+
+        assert( std::all_of(bins.begin(), bins.end(), [size](int k) { return 0 <= k and k < size; }) );
+
+        int nbins = static_cast<int>(bins.size());
+
+        // in units of a Goertzel step per hop, a butterfly operation costs about five of them
+        // and an update of the recurrence two
+        double  fft_cost        = 5.0 * size * std::max(1.0, std::log2(static_cast<double>(size)));
+        double  goertzel_cost   = static_cast<double>(nbins) * size;
+        double  anchor_cost     = all_bins ? fft_cost : std::min(fft_cost, goertzel_cost);
+        double  sliding_cost    = 2.0 * hop * nbins + anchor_cost * hop / interval;
+
+        sliding         = sliding_cost < anchor_cost;
+        anchor_by_fft   = all_bins or fft_cost <= goertzel_cost;
+
+        values.assign(nbins, 0.0);
+
+        for (int k : bins)
+            rotations.push_back(static_cast<complex_t>(std::polar(1.0L, 2 * PI / size * k)));
+    };
+
+    // append a sample, returns true if the spectrum was updated, i.e. every hop samples
+    bool push(complex_t sample)
+    {
+        complex_t oldest = window[head];
+
+        window[head]    = sample;
+        head            = head + 1 == window_size ? 0 : head + 1;
+
+        if (sliding)
+        {
+            complex_t delta = sample - oldest;
+
+            for (size_t i = 0; i < values.size(); ++i)
+                values[i] = (values[i] + delta) * rotations[i];
+
+            if (++since_anchor == interval)
+            {
+                anchor();
+                since_anchor = 0;
+            }
+        }
+
+        if (++since_hop < hop_size)
+            return false;
+
+        since_hop = 0;
+
+        if (not sliding)
+            anchor();
+
+        return true;
+    };
+
+    // bins of the last window in the order of the tracked bins (in natural order for all bins)
+    FftBuffer<complex_t> const& spectrum() const
+    {
+        return values;
+    };
+
+    std::vector<int> const& tracked_bins() const
+    {
+        return bins;
+    };
+
+    bool is_sliding() const
+    {
+        return sliding;
+    };
+
+private:
+    int                     window_size;
+    int                     hop_size;
+    std::vector<int>        bins;
+    bool                    all_bins;
+    bool                    sliding;
+    bool                    anchor_by_fft;
+    FftPlan                 plan;
+    int                     interval;
+    int                     head;
+    int                     since_hop;
+    int                     since_anchor;
+    FftBuffer<complex_t>    window;     // ring buffer, the oldest sample is at head
+    FftBuffer<complex_t>    work;
+    FftBuffer<complex_t>    values;
+    FftBuffer<complex_t>    rotations;  // W_N^(-k) of the tracked bins
+
+    // recompute the tracked bins from the window in chronological order
+    void anchor()
+    {
+        work.resize(window_size);
+        std::rotate_copy(window.begin(), window.begin() + head, window.end(), work.begin());
+
+        int nbins = static_cast<int>(bins.size());
+
+        if (anchor_by_fft)
+        {
+            fft_iterative_breadth_first(work, plan.radices);
+            for (int i = 0; i < nbins; ++i)
+                values[i] = work[bins[i]];
+        }
+        else
+            for (int i = 0; i < nbins; ++i)
+                values[i] = goertzel(work.data(), window_size, window_size, bins[i]);
+    };
+};
+
+#endif
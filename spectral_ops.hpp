@@ -0,0 +1,98 @@
+#ifndef SPECTRAL_OPS_H_
+#define SPECTRAL_OPS_H_
+
+#include <cmath>
+#include <complex>
+#include <cassert>
+#include <limits>
+#include <cstddef>
+#include <algorithm>
+
+#include "ffts.hpp"
+
+// Common operations on batches of spectra with the pre- and post-processing fused into the first and
+// the last pass of the transform (execute_batch_fused), so that neither the windowed input nor the
+// complex spectrum is written to memory before it is consumed. The input blocks are read in the layout of
+// the plan and may have any sample type convertible to complex_t (e.g. std::complex<short> IQ samples),
+// the results of block b are written to out[b * plan.size + k]. A window of plan.size coefficients is
+// applied to every block before the transform, nullptr means no window.
+
+namespace spectral_ops_detail
+{
+
+// element n of block b of the input in the layout of the plan, windowed and scaled
+template <typename complex_t, typename sample_t>
+auto windowed_loader(FftPlan const& plan, sample_t const* in, typename complex_t::value_type const* window, typename complex_t::value_type scale)
+{
+    using real_t = typename complex_t::value_type;
+
+    assert( in != nullptr );
+
+    return [&plan, in, window, scale](int b, int n) {
+        sample_t const& s = in[static_cast<ptrdiff_t>(b) * plan.distance + static_cast<ptrdiff_t>(n) * plan.stride];
+        real_t          w = window == nullptr ? scale : scale * window[n];
+        return complex_t(static_cast<real_t>(std::real(s)) * w, static_cast<real_t>(std::imag(s)) * w);
+    };
+}
+
+}
+
+// out = transform of (scale * window * in) converted to complex_t
+template <typename complex_t, typename sample_t>
+void windowed_transform(FftPlan const& plan, sample_t const* in, typename complex_t::value_type const* window, typename complex_t::value_type scale,
+                        complex_t* out, int howmany, FftBuffer<complex_t>& work)
+{
+    assert( out != nullptr );
+
+    execute_batch_fused(plan, howmany,
+            spectral_ops_detail::windowed_loader<complex_t>(plan, in, window, scale),
+            [&](int b, int k, complex_t const& y) { out[static_cast<ptrdiff_t>(b) * plan.size + k] = y; },
+            work);
+}
+
+// out = |X|^2 of the transform X of the windowed input
+template <typename complex_t, typename sample_t>
+void power_spectrum(FftPlan const& plan, sample_t const* in, typename complex_t::value_type const* window,
+                    typename complex_t::value_type* out, int howmany, FftBuffer<complex_t>& work)
+{
+    assert( out != nullptr );
+
+    execute_batch_fused(plan, howmany,
+            spectral_ops_detail::windowed_loader<complex_t>(plan, in, window, 1),
+            [&](int b, int k, complex_t const& y) { out[static_cast<ptrdiff_t>(b) * plan.size + k] = std::norm(y); },
+            work);
+}
+
+// out = 10 log10(max(|X|^2, floor)) in dB, the floor avoids -inf for empty bins
+template <typename complex_t, typename sample_t>
+void log_power_spectrum(FftPlan const& plan, sample_t const* in, typename complex_t::value_type const* window,
+                        typename complex_t::value_type* out, int howmany, FftBuffer<complex_t>& work,
+                        typename complex_t::value_type floor = std::numeric_limits<typename complex_t::value_type>::min())
+{
+    using real_t = typename complex_t::value_type;
+
+    assert( out != nullptr and floor > 0 );
+
+    execute_batch_fused(plan, howmany,
+            spectral_ops_detail::windowed_loader<complex_t>(plan, in, window, 1),
+            [&](int b, int k, complex_t const& y) {
+                out[static_cast<ptrdiff_t>(b) * plan.size + k] = real_t(10) * std::log10(std::max(std::norm(y), floor));
+            },
+            work);
+}
+
+// out = X conj(R) with the transform X of the windowed input and the spectrum R of a reference signal
+// (plan.size bins shared by all blocks), the backward transform of out is the circular cross-correlation
+template <typename complex_t, typename sample_t>
+void cross_spectrum(FftPlan const& plan, sample_t const* in, typename complex_t::value_type const* window,
+                    complex_t const* reference, complex_t* out, int howmany, FftBuffer<complex_t>& work)
+{
+    assert( reference != nullptr and out != nullptr );
+
+    execute_batch_fused(plan, howmany,
+            spectral_ops_detail::windowed_loader<complex_t>(plan, in, window, 1),
+            [&](int b, int k, complex_t const& y) { out[static_cast<ptrdiff_t>(b) * plan.size + k] = y * std::conj(reference[k]); },
+            work);
+}
+
+#endif
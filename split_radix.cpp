@@ -0,0 +1,11 @@
+#include <cassert>
+#include <algorithm>
+
+#include "split_radix.hpp"
+
+SplitRadixPlan make_split_radix_plan(int size)
+{
+    assert( size > 0 and (size & (size - 1)) == 0 );
+
+    return SplitRadixPlan{size, shared_twiddles(size, std::max(size / 4, 1))};
+}
@@ -0,0 +1,99 @@
+#ifndef SPLIT_RADIX_H_
+#define SPLIT_RADIX_H_
+
+#include <vector>
+#include <complex>
+#include <cassert>
+
+#include "ffts.hpp"
+#include "fixed_ffts.hpp"
+
+// Setup of a conjugate-pair split-radix transform of a power-of-two size N. Every step splits
+// the input into the even elements (a transform of size N/2) and the elements 4n+1 and 4n-1 (two
+// transforms of size N/4), which are combined with the twiddle factors W_N^k and W_N^-k. This needs
+// the fewest real operations of the power-of-two algorithms in use, 4 N log2 N - 6 N + 8, and only the
+// conjugate pairs of one table of twiddle factors, which serves all sub-transforms with a stride.
+struct SplitRadixPlan
+{
+    int             size;
+    TwiddleView     twiddles;   // W_N^k for 0 <= k < size / 4
+};
+
+SplitRadixPlan make_split_radix_plan(int size);
+
+namespace split_radix_detail
+{
+
+// out[0, n) = DFT of the inputs in[(offset + j stride) mod N], 0 <= j < n, mask = N - 1,
+// the twiddle factors of size n are W_N^(k N / n) = twiddles[k * twiddle_stride]
+template <typename complex_t>
+void transform(complex_t const* in, int mask, int offset, int stride, complex_t* out, int n,
+               std::complex<double> const* twiddles, int twiddle_stride)
+{
+    if (n == 1)
+    {
+        out[0] = in[offset & mask];
+        return;
+    }
+
+    if (n == 2 or n == 4)
+    {
+        for (int j = 0; j < n; ++j)
+            out[j] = in[(offset + j * stride) & mask];
+
+        if (n == 2)
+            fixed_detail::Codelet<complex_t, 2>::apply(out);
+        else
+            fixed_detail::Codelet<complex_t, 4>::apply(out);
+
+        return;
+    }
+
+    int const quarter = n / 4;
+
+    complex_t* u    = out;
+    complex_t* z    = out + 2 * quarter;
+    complex_t* zc   = out + 3 * quarter;
+
+    transform(in, mask, offset, 2 * stride, u, 2 * quarter, twiddles, 2 * twiddle_stride);
+    transform(in, mask, offset + stride, 4 * stride, z, quarter, twiddles, 4 * twiddle_stride);
+    transform(in, mask, offset - stride, 4 * stride, zc, quarter, twiddles, 4 * twiddle_stride);
+
+    for (int k = 0; k < quarter; ++k)
+    {
+        complex_t w     = static_cast<complex_t>(twiddles[k * twiddle_stride]);
+        complex_t a     = w * z[k];
+        complex_t b     = std::conj(w) * zc[k];
+        complex_t s     = a + b;
+        complex_t d     = a - b;
+        // multiplication by -i
+        complex_t md    = complex_t(d.imag(), -d.real());
+
+        complex_t u0    = u[k];
+        complex_t u1    = u[k + quarter];
+
+        u[k]                = u0 + s;
+        u[k + quarter]      = u1 + md;
+        z[k]                = u0 - s;
+        zc[k]               = u1 - md;
+    }
+}
+
+}
+
+// forward transform, returns the spectrum in natural order in x like the mixed-radix kernels
+template <typename complex_t>
+FftBuffer<complex_t> fft_split_radix(FftBuffer<complex_t>& x, SplitRadixPlan const& plan)
+{
+    assert( static_cast<int>(x.size()) == plan.size );
+
+    FftBuffer<complex_t> out(x.size());
+
+    split_radix_detail::transform(x.data(), plan.size - 1, 0, 1, out.data(), plan.size, plan.twiddles.table->data(), plan.twiddles.stride);
+
+    x = std::move(out);
+
+    return x;
+}
+
+#endif
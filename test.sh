@@ -1,7 +1,31 @@
 #!/bin/bash
 
 # The test script doesn't test all option combinations!
+# It stops at the first test that fails.
+
+set -e
 
 $1 -a 1 -g 1 -t 2 -p "Accuracy test: iterative, factors, powers-of-2"
 $1 -a 2 -g 1 -t 2 -p "Accuracy test: recursive, factors, powers-of-2"
-$1 -a 1 -g 3 -r 16 -t 2 -p "Accuracy test: iterative, thresholded (16), powers-of-2"
\ No newline at end of file
+$1 -a 1 -g 3 -r 16 -t 2 -p "Accuracy test: iterative, thresholded (16), powers-of-2"
+$1 -a 4 -g 1 -T 4 -t 2 -p "Accuracy test: four-step parallel (4 threads), factors, powers-of-2"
+$1 -g 1 -t 4 -R 4 -p "Distributed test: 4 processes, factors, powers-of-2"
+$1 -a 5 -g 1 -T 4 -t 2 -p "Accuracy test: recursive work-stealing (4 threads), factors, powers-of-2"
+$1 -g 3 -r 16 -t 5 -T 4 -p "Plan cache test: batched layouts, concurrent lookups (4 threads), thresholded (16)"
+$1 -a 7 -g 1 -t 2 -p "Accuracy test: split-radix, powers-of-2"
+$1 -a 8 -g 3 -r 16 -t 2 -p "Accuracy test: iterative with a shared twiddle table, thresholded (16)"
+$1 -g 1 -t 6 -p "Fixed-size test: compile-time transforms against runtime plans"
+$1 -g 1 -t 7 -p "Pruned test: input and output pruning, factors, powers-of-2"
+$1 -g 1 -t 8 -p "Trigonometric test: DCT and DST types I-IV, factors"
+$1 -g 1 -t 9 -p "Sliding DFT test: hops and tracked bins, factors, powers-of-2"
+$1 -g 1 -t 10 -p "Size test: next fast size and chirp-z, factors"
+if [ -x ./fftw_shim_test ]; then
+    ./fftw_shim_test
+else
+    echo "FFTW shim test skipped: ./fftw_shim_test is not built (make fftw_shim_test)"
+fi
+$1 -g 1 -t 11 -p "Spectral test: fused window, power, log-power and cross spectra, factors, powers-of-2"
+$1 -g 1 -t 12 -S 256 -p "Accuracy suite: all engines, radix options, precisions and directions up to size 256"
+$1 -g 3 -r 16 -t 13 -T 2 -p "Asynchronous test: latency under concurrent load, thresholded (16), powers-of-2"
+$1 -g 3 -r 16 -t 14 -p "Planning test: plans per second of random lengths, shared twiddle tables, thresholded (16)"
+$1 -g 3 -r 16 -t 15 -p "Profile: time, peak RSS, scratch bytes, stage footprints and energy per transform as CSV, thresholded (16), powers-of-2"
@@ -6,10 +6,35 @@
 #include <cstdlib>
 #include <limits>
 #include <string>
+#include <thread>
+#include <memory>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <random>
+#include <sstream>
+#include <algorithm>
 #include <getopt.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include <fftw3.h>
 
 #include "ffts.hpp"
+#include "parallel_ffts.hpp"
+#include "distributed_ffts.hpp"
+#include "PlanCache.hpp"
+#include "fixed_ffts.hpp"
+#include "pruned_ffts.hpp"
+#include "trig_transforms.hpp"
+#include "sliding_dft.hpp"
+#include "fast_sizes.hpp"
+#include "chirp_z.hpp"
+#include "spectral_ops.hpp"
+#include "reference_fft.hpp"
+#include "split_radix.hpp"
+#include "async_ffts.hpp"
+#include "profiling.hpp"
 #include "utils.hpp"
 
 #define REPETITIONS 10
@@ -20,11 +45,11 @@ using namespace std;
 template <typename complex_t>
 struct TestInstance {
     int size;
-    vector<complex_t> in;
-    vector<complex_t> out;
+    FftBuffer<complex_t> in;
+    FftBuffer<complex_t> out;
 
     TestInstance() : size{}, in{}, out{} {};
-    TestInstance(int size, vector<complex_t> in, vector<complex_t> out) : size{size}, in{in}, out{out} {};
+    TestInstance(int size, FftBuffer<complex_t> in, FftBuffer<complex_t> out) : size{size}, in{in}, out{out} {};
 };
 
 // utility function to generate random test instances of a given size
@@ -38,21 +63,25 @@ TestInstance<complex_t> generate_test_instance(int size, int seed) {
     for (int i = 0; i < size; ++i)
         test_instance.in.emplace_back( static_cast<double>(rand()) / RAND_MAX, static_cast<double>(rand()) / RAND_MAX );
     
-    vector<complex<long double>>    test_in_ld(test_instance.in.begin(), test_instance.in.end());
-    vector<complex<long double>>    test_out_ld = dft_matrix_mult<complex<long double>>(test_in_ld);
+    FftBuffer<complex<long double>>    test_in_ld(test_instance.in.begin(), test_instance.in.end());
+    FftBuffer<complex<long double>>    test_out_ld = reference_fft(test_in_ld);
     
-    test_instance.out = vector<complex_t>(test_out_ld.begin(), test_out_ld.end());
+    test_instance.out = FftBuffer<complex_t>(test_out_ld.begin(), test_out_ld.end());
     
     return test_instance;
 }
 
 // enum type for the different algorithms
-enum Algorithm {recursive_depth_first, iterative_breadth_first, fftw_lib};
+enum Algorithm {recursive_depth_first, iterative_breadth_first, fftw_lib, four_step_parallel, recursive_work_stealing, recursive_omp_static, split_radix, iterative_shared_twiddles};
 
 // simple struct to store setup information i.e. parameters of the radix computation
 struct SetupInfo {
     int                     radix_option;
     int                     radix_threshold;
+    int                     nthreads;
+    bool                    pin_threads;
+    int                     nranks;
+    int                     grain_size;
     static constexpr int    not_used = std::numeric_limits<int>::max();
 };
 
@@ -65,14 +94,20 @@ void test_accuracy(string const& text, Algorithm a, SetupInfo const& setup_info)
     using std::chrono::duration;
     using std::chrono::milliseconds;
 
-    // generate test instances
+    // generate test instances, the split-radix algorithm only transforms powers of 2
     vector<TestInstance<complex_t>> test_instances; 
-    test_instances.push_back(generate_test_instance<complex_t>(2 * 2 * 2 * 3 * 5 * 7, 43));
-    test_instances.push_back(generate_test_instance<complex_t>(3 * 5 * 11 * 13, 43));
-    test_instances.push_back(generate_test_instance<complex_t>(2 * 2 * 2 * 2 * 3 * 37, 43));
-    test_instances.push_back(generate_test_instance<complex_t>(27000, 43));
-    int size = 2 * 2 * 2 * 2 * 3 * 37;
-    test_instances.emplace_back(size, vector<complex_t>(size, 0.0), vector<complex_t>(size, 0.0));
+    if (a == split_radix)
+    {
+        test_instances.push_back(generate_test_instance<complex_t>(64, 43));
+        test_instances.push_back(generate_test_instance<complex_t>(2048, 43));
+        test_instances.push_back(generate_test_instance<complex_t>(32768, 43));
+    } else
+    {
+        test_instances.push_back(generate_test_instance<complex_t>(2 * 2 * 2 * 3 * 5 * 7, 43));
+        test_instances.push_back(generate_test_instance<complex_t>(3 * 5 * 11 * 13, 43));
+        test_instances.push_back(generate_test_instance<complex_t>(2 * 2 * 2 * 2 * 3 * 37, 43));
+        test_instances.push_back(generate_test_instance<complex_t>(27000, 43));
+    }
 
     cout << text << endl;
 
@@ -81,9 +116,15 @@ void test_accuracy(string const& text, Algorithm a, SetupInfo const& setup_info)
 
         for (auto test_instance : test_instances) {
             
-            vector<complex_t>               out;
+            FftBuffer<complex_t>            out;
             vector<int>                     radices;
+            FourStepPlan                    four_step_plan;
+            SplitRadixPlan                  split_radix_plan;
+            TwiddleView                     twiddles;
+            unique_ptr<WorkStealingPool>    pool;
             duration<double, std::milli>    duration_ms;
+            FftBuffer<complex<double>>      in_fftw_buffer;
+            FftBuffer<complex<double>>      out_fftw_buffer;
             auto                            start_time_ms = high_resolution_clock::now();
 
             switch (a)
@@ -100,6 +141,39 @@ void test_accuracy(string const& text, Algorithm a, SetupInfo const& setup_info)
                 out             = fft_iterative_breadth_first(test_instance.in, radices);
                 duration_ms     = high_resolution_clock::now() - start_time_ms;
                 break;
+            case four_step_parallel:
+                four_step_plan  = make_four_step_plan(test_instance.size, setup_info.radix_option, setup_info.radix_threshold, setup_info.nthreads, setup_info.pin_threads);
+                start_time_ms   = high_resolution_clock::now();
+                fft_four_step_parallel(test_instance.in, four_step_plan);
+                duration_ms     = high_resolution_clock::now() - start_time_ms;
+                out             = test_instance.in;
+                break;
+            case recursive_work_stealing:
+                radices         = compute_radices(test_instance.size, setup_info.radix_option, setup_info.radix_threshold);
+                pool            = make_unique<WorkStealingPool>(setup_info.nthreads, setup_info.pin_threads);
+                start_time_ms   = high_resolution_clock::now();
+                out             = fft_recursive_depth_first_tasks(test_instance.in, radices, *pool, setup_info.grain_size);
+                duration_ms     = high_resolution_clock::now() - start_time_ms;
+                break;
+            case recursive_omp_static:
+                radices         = compute_radices(test_instance.size, setup_info.radix_option, setup_info.radix_threshold);
+                start_time_ms   = high_resolution_clock::now();
+                out             = fft_recursive_depth_first_omp(test_instance.in, radices, setup_info.nthreads);
+                duration_ms     = high_resolution_clock::now() - start_time_ms;
+                break;
+            case split_radix:
+                split_radix_plan    = make_split_radix_plan(test_instance.size);
+                start_time_ms       = high_resolution_clock::now();
+                out                 = fft_split_radix(test_instance.in, split_radix_plan);
+                duration_ms         = high_resolution_clock::now() - start_time_ms;
+                break;
+            case iterative_shared_twiddles:
+                radices         = compute_radices(test_instance.size, setup_info.radix_option, setup_info.radix_threshold);
+                twiddles        = shared_twiddles(test_instance.size);
+                start_time_ms   = high_resolution_clock::now();
+                out             = fft_iterative_breadth_first(test_instance.in, radices, twiddles);
+                duration_ms     = high_resolution_clock::now() - start_time_ms;
+                break;
             case fftw_lib:
                 fftw_complex    *in;
                 fftw_complex    *out_fftw;
@@ -107,8 +181,11 @@ void test_accuracy(string const& text, Algorithm a, SetupInfo const& setup_info)
 
                 //fftw_init_threads();
 
-                in          = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * test_instance.size);
-                out_fftw    = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * test_instance.size);
+                // FFTW works on the same aligned storage as the own implementations
+                in_fftw_buffer  = FftBuffer<complex<double>>(test_instance.size);
+                out_fftw_buffer = FftBuffer<complex<double>>(test_instance.size);
+                in              = reinterpret_cast<fftw_complex*>(in_fftw_buffer.data());
+                out_fftw        = reinterpret_cast<fftw_complex*>(out_fftw_buffer.data());
 
                 //fftw_plan_with_nthreads(4);
 
@@ -132,8 +209,6 @@ void test_accuracy(string const& text, Algorithm a, SetupInfo const& setup_info)
                 }
 
                 fftw_destroy_plan(p);
-                fftw_free(in);
-                fftw_free(out_fftw);
                 break;
             }
             
@@ -148,6 +223,41 @@ void test_accuracy(string const& text, Algorithm a, SetupInfo const& setup_info)
 
         cout << endl;
     }
+
+    // a worker that fails before the barriers of the four-step transform must not leave the others waiting
+    if (a == four_step_parallel and setup_info.nthreads > 1)
+    {
+        FourStepPlan plan = make_four_step_plan(64, setup_info.radix_option, setup_info.radix_threshold, setup_info.nthreads);
+
+        for (int failing = 0; failing < setup_info.nthreads; ++failing)
+        {
+            bool reported = false;
+            try
+            {
+                run_with_barrier(*plan.team, [&](int t, Barrier& barrier) {
+                    if (t == failing)
+                        throw runtime_error("failing worker");
+                    barrier.wait();
+                    barrier.wait();
+                });
+            }
+            catch (runtime_error const& e)
+            {
+                reported = string(e.what()) == "failing worker";
+            }
+
+            if (not reported)
+                throw logic_error("the failure of a worker was not reported");
+        }
+
+        // the team is still usable
+        FftBuffer<complex_t> x(64, 1.0);
+        fft_four_step_parallel(x, plan);
+        if (abs(x[0] - complex_t(64.0)) > 1e-3)
+            throw logic_error("wrong transform after a failed job");
+
+        cout << "failing workers are reported: yes" << endl << endl;
+    }
 }
 
 template <typename complex_t>
@@ -165,13 +275,13 @@ void test_speed(string const& text, Algorithm a, SetupInfo const& setup_info, bo
         int size = 32;
         for (size_t i = 0; i < 10; ++i) {
             size *= 2;
-            test_instances.emplace_back(size, vector<complex_t>(size, 0.0), vector<complex_t>(size, 0.0));
+            test_instances.emplace_back(size, FftBuffer<complex_t>(size, 0.0), FftBuffer<complex_t>(size, 0.0));
         }
     } else
     {
         vector<int> sizes = {6, 9, 12, 15, 18, 24, 36, 80, 108, 210, 504, 1000, 1960, 4725, 10368, 27000, 75600, 165375};
         for (int size : sizes)
-            test_instances.emplace_back(size, vector<complex_t>(size, 0.0), vector<complex_t>(size, 0.0));
+            test_instances.emplace_back(size, FftBuffer<complex_t>(size, 0.0), FftBuffer<complex_t>(size, 0.0));
     }
 
     cout << text << endl;
@@ -181,9 +291,15 @@ void test_speed(string const& text, Algorithm a, SetupInfo const& setup_info, bo
 
         for (auto test_instance : test_instances) {
             
-            vector<complex_t>               out;
+            FftBuffer<complex_t>            out;
             vector<int>                     radices;
+            FourStepPlan                    four_step_plan;
+            SplitRadixPlan                  split_radix_plan;
+            TwiddleView                     twiddles;
+            unique_ptr<WorkStealingPool>    pool;
             duration<double, std::milli>    duration_ms;
+            FftBuffer<complex<double>>      in_fftw_buffer;
+            FftBuffer<complex<double>>      out_fftw_buffer;
             auto start_time_ms = high_resolution_clock::now();
 
             switch (a)
@@ -202,6 +318,54 @@ void test_speed(string const& text, Algorithm a, SetupInfo const& setup_info, bo
                 for (int i = 0; i < REPETITIONS; ++i)
                     out = fft_iterative_breadth_first(test_instance.in, radices);
                 
+                duration_ms = high_resolution_clock::now() - start_time_ms;
+                break;
+            case four_step_parallel:
+                four_step_plan  = make_four_step_plan(test_instance.size, setup_info.radix_option, setup_info.radix_threshold, setup_info.nthreads, setup_info.pin_threads);
+                start_time_ms   = high_resolution_clock::now();
+
+                for (int i = 0; i < REPETITIONS; ++i)
+                    fft_four_step_parallel(test_instance.in, four_step_plan);
+
+                duration_ms = high_resolution_clock::now() - start_time_ms;
+                break;
+            case recursive_work_stealing:
+                radices         = compute_radices(test_instance.size, setup_info.radix_option, setup_info.radix_threshold);
+                pool            = make_unique<WorkStealingPool>(setup_info.nthreads, setup_info.pin_threads);
+                start_time_ms   = high_resolution_clock::now();
+
+                for (int i = 0; i < REPETITIONS; ++i)
+                    out = fft_recursive_depth_first_tasks(test_instance.in, radices, *pool, setup_info.grain_size);
+
+                duration_ms = high_resolution_clock::now() - start_time_ms;
+                break;
+            case recursive_omp_static:
+                radices         = compute_radices(test_instance.size, setup_info.radix_option, setup_info.radix_threshold);
+                start_time_ms   = high_resolution_clock::now();
+
+                for (int i = 0; i < REPETITIONS; ++i)
+                    out = fft_recursive_depth_first_omp(test_instance.in, radices, setup_info.nthreads);
+
+                duration_ms = high_resolution_clock::now() - start_time_ms;
+                break;
+            case split_radix:
+                split_radix_plan    = make_split_radix_plan(test_instance.size);
+                start_time_ms       = high_resolution_clock::now();
+
+                for (int i = 0; i < REPETITIONS; ++i)
+                    out = fft_split_radix(test_instance.in, split_radix_plan);
+
+                duration_ms = high_resolution_clock::now() - start_time_ms;
+                break;
+            case iterative_shared_twiddles:
+                // the same table as a split-radix plan of this size
+                radices         = compute_radices(test_instance.size, setup_info.radix_option, setup_info.radix_threshold);
+                twiddles        = shared_twiddles(test_instance.size);
+                start_time_ms   = high_resolution_clock::now();
+
+                for (int i = 0; i < REPETITIONS; ++i)
+                    out = fft_iterative_breadth_first(test_instance.in, radices, twiddles);
+
                 duration_ms = high_resolution_clock::now() - start_time_ms;
                 break;
             case fftw_lib:
@@ -211,8 +375,11 @@ void test_speed(string const& text, Algorithm a, SetupInfo const& setup_info, bo
 
                 //fftw_init_threads();
 
-                in          = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * test_instance.size);
-                out_fftw    = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * test_instance.size);
+                // FFTW works on the same aligned storage as the own implementations
+                in_fftw_buffer  = FftBuffer<complex<double>>(test_instance.size);
+                out_fftw_buffer = FftBuffer<complex<double>>(test_instance.size);
+                in              = reinterpret_cast<fftw_complex*>(in_fftw_buffer.data());
+                out_fftw        = reinterpret_cast<fftw_complex*>(out_fftw_buffer.data());
 
                 //fftw_plan_with_nthreads(4);
 
@@ -233,8 +400,6 @@ void test_speed(string const& text, Algorithm a, SetupInfo const& setup_info, bo
                 duration_ms = high_resolution_clock::now() - start_time_ms;
 
                 fftw_destroy_plan(p);
-                fftw_free(in);
-                fftw_free(out_fftw);
                 break;
             }
             
@@ -251,116 +416,1993 @@ void test_speed(string const& text, Algorithm a, SetupInfo const& setup_info, bo
 
 
 
-int main(int argc, char ** argv){
-    
-    constexpr char const* const options = "a:g:hnp:r:st:";
-    constexpr char const* const usage = " [options]\n" \
-        " -a n         Choose algorithm: 1 = iterative, 2 = recursive, 3 = FFTW (3)\n" \
-        " -g n         Choose algorithm for radix generation: 1 = factors, 2 = factors reversed, 3 = thresholded (1)\n" \
-        " -r n         Threshold for radix generation (not used)\n" \
-        " -t n         Choose test: 1 = performance, 2 = accuracy (1)\n" \
-        " -n           Use non-powers-of-2\n" \
-        " -s           Use single precision\n" \
-        " -p text      Print text before the test\n" \
-        " -h           Show this help\n" \
-        "\n";
-    
+// function that reports the strong scaling of a parallel FFT algorithm over the number of threads
+template <typename complex_t>
+void test_scaling(string const& text, Algorithm a, SetupInfo const& setup_info, bool use_powers_of_2) {
     using std::fixed;
     using std::chrono::high_resolution_clock;
-    using std::chrono::duration_cast;
     using std::chrono::duration;
-    using std::chrono::milliseconds;
 
-    try 
+    vector<int> sizes;
+    if (use_powers_of_2)
+        sizes = {1 << 12, 1 << 14, 1 << 16, 1 << 18};
+    else
+        sizes = {2145, 4725, 27000, 75600, 165375};
+
+    // powers of 2 up to the maximal number of threads and the maximal number itself
+    vector<int> thread_counts;
+    for (int nthreads = 1; nthreads < setup_info.nthreads; nthreads *= 2)
+        thread_counts.push_back(nthreads);
+    thread_counts.push_back(setup_info.nthreads);
+
+    vector<NumaNode> nodes = read_numa_topology();
+
+    cout << text << endl;
+    cout << "NUMA nodes: " << nodes.size() << ", threads pinned: " << (setup_info.pin_threads ? "yes" : "no") << endl;
+
     {
-        int     algo                    = 3;
-        int     algo_radix              = SetupInfo::not_used;
-        int     radix_threshold         = SetupInfo::not_used;
-        int     test_type               = 1;
-        bool    use_powers_of_two       = true;
-        bool    use_single_precision    = false;
-        string  preamble                = "";
-        int     c;
+        cout << "  size  threads   time (ms)   average (ms)   speedup   efficiency" << endl;
 
-        while((c = getopt(argc, argv, options)) != -1)
-        {
-            switch(c)
+        for (int size : sizes) {
+
+            vector<int>     radices         = compute_radices(size, setup_info.radix_option, setup_info.radix_threshold);
+            double          serial_time_ms  = 0.0;
+
+            for (int nthreads : thread_counts)
             {
-            case 'a' :
-                algo = stoi(optarg);
-                break;
-            case 'g' :
-                algo_radix = stoi(optarg);
-                break;
-            case 'r' :
-                radix_threshold = stoi(optarg);
-                break;
-            case 't' :
-                test_type = stoi(optarg);
-                break;
-            case 'n' :
-                use_powers_of_two = false;
-                break;
-            case 's' :
-                use_single_precision = true;
-                break;
-            case 'p' :
-                preamble = string(optarg);
-                break;
-            case 'h' :
-                cout << "usage: " << argv[0] << usage;
-                return 0;
-            case '?' :
-            default :
-                cerr << "unknown option [" << c << "]\n";
-                cerr << "usage: " << argv[0] << usage;
-                return -1;
+                FftBuffer<complex_t>    x(size, 0.0);
+                WorkStealingPool        pool(a == recursive_work_stealing ? nthreads : 1, setup_info.pin_threads);
+                FourStepPlan            plan = make_four_step_plan(size, setup_info.radix_option, setup_info.radix_threshold,
+                                                                   a == four_step_parallel ? nthreads : 0, setup_info.pin_threads);
+
+                auto start_time_ms = high_resolution_clock::now();
+
+                for (int i = 0; i < REPETITIONS; ++i)
+                {
+                    if (a == four_step_parallel)
+                        fft_four_step_parallel(x, plan);
+                    else if (a == recursive_work_stealing)
+                        fft_recursive_depth_first_tasks(x, radices, pool, setup_info.grain_size);
+                    else
+                        fft_recursive_depth_first_omp(x, radices, nthreads);
+                }
+
+                duration<double, std::milli> duration_ms = high_resolution_clock::now() - start_time_ms;
+
+                if (nthreads == 1)
+                    serial_time_ms = duration_ms.count();
+
+                double speedup = serial_time_ms / duration_ms.count();
+
+                int const default_precision = static_cast<int>(std::cout.precision());
+                cout << setw(6) << size
+                        << setw(9) << nthreads
+                        << setw(12) << setprecision(2) << fixed << duration_ms.count()
+                        << setw(15) << fixed << setprecision(4) << duration_ms.count() / static_cast<double>(REPETITIONS)
+                        << setw(10) << fixed << setprecision(2) << speedup
+                        << setw(13) << fixed << setprecision(2) << speedup / nthreads
+                        << endl;
+                cout << setprecision(default_precision);
             }
         }
-        if (algo < 1 or algo > 3 or (algo_radix != SetupInfo::not_used and (algo_radix < 1 or algo_radix > 3)) or test_type < 1 or test_type > 2)
-        {
-            cerr << algo << " " << algo_radix << " " << test_type << endl;
-            cerr << "usage: " << argv[0] << usage;
-            return -2;
+    }
+}
+
+// function that tests the distributed FFTs on processes connected by the shared memory transport
+template <typename complex_t>
+void test_distributed(string const& text, SetupInfo const& setup_info, bool use_powers_of_2) {
+    using std::fixed;
+    using std::chrono::high_resolution_clock;
+    using std::chrono::duration;
+
+    // one-dimensional sizes and two-dimensional shapes (rows x columns)
+    vector<pair<int, int>> shapes;
+    if (use_powers_of_2)
+        shapes = {{1 << 12, 1}, {1 << 14, 1}, {1 << 16, 1}, {64, 64}, {128, 256}, {256, 256}};
+    else
+        shapes = {{10368, 1}, {27000, 1}, {75600, 1}, {60, 60}, {120, 180}, {240, 240}};
+
+    int const   nranks  = setup_info.nranks;
+    int const   nchunks = 4;
+
+    cout << text << endl;
+
+    {
+        cout << "      shape   ranks   time (ms)   max-norm vs. local" << endl;
+
+        for (auto shape : shapes) {
+
+            int     nrows   = shape.first;
+            int     ncols   = shape.second;
+            int     size    = nrows * ncols;
+            bool    is_1d   = ncols == 1;
+
+            FourStepPlan    four_step_plan  = make_four_step_plan(size, setup_info.radix_option, setup_info.radix_threshold);
+            FftPlan         row_plan        = make_plan(ncols, setup_info.radix_option, setup_info.radix_threshold);
+            FftPlan         column_plan     = make_plan(nrows, setup_info.radix_option, setup_info.radix_threshold);
+
+            int const default_precision = static_cast<int>(std::cout.precision());
+            cout << setw(11) << (is_1d ? to_string(size) : to_string(nrows) + "x" + to_string(ncols)) << setw(8) << nranks;
+
+            bool divisible = is_1d ? four_step_plan.n1 % nranks == 0 and four_step_plan.n2 % nranks == 0
+                                   : nrows % nranks == 0 and ncols % nranks == 0;
+            if (not divisible)
+            {
+                cout << "     skipped, not divisible by the number of ranks" << endl;
+                continue;
+            }
+
+            FftBuffer<complex_t> x(size);
+            srand(43);
+            for (auto& element : x)
+                element = complex_t(static_cast<typename complex_t::value_type>(static_cast<double>(rand()) / RAND_MAX),
+                                    static_cast<typename complex_t::value_type>(static_cast<double>(rand()) / RAND_MAX));
+
+            // every rank stores its part of the result in memory shared with rank 0
+            size_t      result_bytes    = static_cast<size_t>(size) * sizeof(complex_t);
+            void*       mapping         = mmap(nullptr, result_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+            if (mapping == MAP_FAILED)
+                throw bad_alloc();
+            complex_t*  result          = static_cast<complex_t*>(mapping);
+
+            duration<double, std::milli>    duration_ms;
+            size_t                          capacity    = static_cast<size_t>(size) / nranks / nranks * sizeof(complex_t);
+
+            bool success = SharedMemoryTransport::run(nranks, capacity, nchunks, [&](Transport& transport) {
+                int     rank        = transport.rank();
+                size_t  local_size  = static_cast<size_t>(size) / nranks;
+
+                FftBuffer<complex_t> local(x.begin() + static_cast<long>(rank * local_size), x.begin() + static_cast<long>((rank + 1) * local_size));
+
+                transport.barrier();
+                auto start_time_ms = high_resolution_clock::now();
+
+                if (is_1d)
+                    fft_distributed_1d(transport, local, four_step_plan, nchunks);
+                else
+                    fft_distributed_2d(transport, local, row_plan, column_plan, nchunks);
+
+                transport.barrier();
+                duration_ms = high_resolution_clock::now() - start_time_ms;
+
+                copy(local.begin(), local.end(), result + rank * local_size);
+
+                return true;
+            });
+
+            // reference: the same transform on a single process
+            if (is_1d)
+            {
+                vector<int> radices = compute_radices(size, setup_info.radix_option, setup_info.radix_threshold);
+                fft_iterative_breadth_first(x, radices);
+            }
+            else
+            {
+                FftBuffer<complex_t> work;
+                execute_batch(row_plan, x.data(), nrows, work);
+                FftBuffer<complex_t> transposed(size);
+                for (int i = 0; i < nrows; ++i)
+                    for (int j = 0; j < ncols; ++j)
+                        transposed[static_cast<size_t>(j) * nrows + i] = x[static_cast<size_t>(i) * ncols + j];
+                execute_batch(column_plan, transposed.data(), ncols, work);
+                for (int i = 0; i < nrows; ++i)
+                    for (int j = 0; j < ncols; ++j)
+                        x[static_cast<size_t>(i) * ncols + j] = transposed[static_cast<size_t>(j) * nrows + i];
+            }
+
+            FftBuffer<complex_t> out(result, result + size);
+            munmap(mapping, result_bytes);
+
+            if (not success)
+                throw runtime_error("a rank of the distributed FFT failed");
+
+            cout << setw(12) << setprecision(2) << fixed << duration_ms.count()
+                    << setw(21) << fixed << setprecision(12) << max_norm(x - out)
+                    << endl;
+            cout << setprecision(default_precision);
         }
-        
-        if ((algo == 1 or algo == 2) and algo_radix == SetupInfo::not_used)
+
+        cout << endl;
+    }
+
+    // a failing rank must not leave the other ranks waiting: the last rank fails, an early
+    // ending rank stops before the exchange, the others are released from the barrier
+    if (nranks > 1)
+    {
+        for (bool early_exit : {false, true})
         {
-            cerr << "for algorithm " << algo << " a radix generation algorithm must be specified" << endl;
-            cerr << "usage: " << argv[0] << usage;
-            return -3;
+            bool success = SharedMemoryTransport::run(nranks, 64, 1, [&](Transport& transport) {
+                if (transport.rank() == transport.size() - 1)
+                {
+                    if (early_exit)
+                        _exit(EXIT_SUCCESS);
+                    throw runtime_error("failure of a rank");
+                }
+
+                vector<char> send(transport.size()), recv(transport.size());
+
+                transport.barrier();
+                transport.alltoall(send.data(), recv.data(), 1);
+
+                return true;
+            });
+
+            if (success)
+                throw logic_error("the failure of a rank was not reported");
         }
 
-        Algorithm a;
-        switch (algo)
+        cout << "failing ranks are reported: yes" << endl << endl;
+    }
+}
+
+// function that measures the latency of concurrent plan lookups with and without the plan cache
+template <typename complex_t>
+void test_plan_cache(string const& text, SetupInfo const& setup_info) {
+    using std::fixed;
+    using std::chrono::steady_clock;
+    using std::chrono::duration;
+
+    int const   nlookups    = 20000;
+    int const   nthreads    = setup_info.nthreads;
+
+    // a few dozen distinct lengths with different factorizations
+    vector<int> sizes;
+    for (int i = 1; i <= 48; ++i)
+        sizes.push_back(256 * i);
+
+    int radix_option    = setup_info.radix_option;
+    int radix_threshold = setup_info.radix_threshold;
+
+    cout << text << endl;
+
+    // batches of cached plans in strided and interleaved layouts and in both directions against the reference
+    {
+        using real_t = typename complex_t::value_type;
+
+        struct Layout
         {
-        case 1:
-            a = iterative_breadth_first;
-            break;
-        case 2:
-            a = recursive_depth_first;
-            break;
-        case 3:
-            a = fftw_lib;
-            break;
+            int size;
+            int direction;
+            int stride;
+            int distance;
+            int howmany;
+        };
+
+        double const tolerance = sizeof(real_t) == sizeof(float) ? 1e-4 : 1e-10;
+
+        for (Layout layout : {Layout{60, FFT_FORWARD, 1, 60, 3}, Layout{64, FFT_BACKWARD, 1, 70, 4}, Layout{48, FFT_FORWARD, 3, 3 * 48 + 5, 2},
+                              Layout{45, FFT_BACKWARD, 4, 1, 4}, Layout{1000, FFT_BACKWARD, 2, 2001, 3}})
+        {
+            size_t                  extent = static_cast<size_t>(layout.howmany - 1) * layout.distance + static_cast<size_t>(layout.size - 1) * layout.stride + 1;
+            FftBuffer<complex_t>    data(extent);
+
+            for (size_t i = 0; i < extent; ++i)
+                data[i] = complex_t(static_cast<real_t>(sin(0.7 * static_cast<double>(i))), static_cast<real_t>(cos(0.3 * static_cast<double>(i * i % 101))));
+
+            FftBuffer<complex_t> original = data;
+
+            fft_cached(data.data(), layout.size, layout.direction, layout.howmany, layout.stride, layout.distance);
+
+            double error = 0.0;
+
+            for (int b = 0; b < layout.howmany; ++b)
+            {
+                FftBuffer<complex<long double>> block(layout.size);
+                for (int i = 0; i < layout.size; ++i)
+                    block[i] = original[static_cast<size_t>(b) * layout.distance + static_cast<size_t>(i) * layout.stride];
+
+                FftBuffer<complex<long double>> expected = reference_fft(block, layout.direction);
+
+                for (int k = 0; k < layout.size; ++k)
+                    error = max(error, static_cast<double>(abs(expected[k] - static_cast<complex<long double>>(data[static_cast<size_t>(b) * layout.distance + static_cast<size_t>(k) * layout.stride]))));
+            }
+
+            if (error > tolerance * layout.size)
+                throw logic_error("cached batch of size " + to_string(layout.size) + ", stride " + to_string(layout.stride) + ", distance "
+                                  + to_string(layout.distance) + " differs from the reference by " + to_string(error));
         }
 
-        SetupInfo setup_info{algo_radix, radix_threshold};
+        cout << "batched layouts and directions: correct" << endl;
+    }
 
-        if (test_type == 1) {
+    // eviction in the order of last use, and misses into a full cache at the cap of the global cache
+    {
+        int const   precision   = static_cast<int>(sizeof(typename complex_t::value_type));
+        auto        key         = [&](int size) { return PlanKey{size, precision, FFT_FORWARD, 1, size}; };
+        PlanCache   small(3, radix_option, radix_threshold);
+
+        for (int size : {10, 20, 30})
+            small.get(key(size));
+
+        // last uses closer than a millisecond are not told apart
+        this_thread::sleep_for(std::chrono::milliseconds(2));
+        small.get(key(10));
+        small.get(key(40));
+
+        long misses = small.stats().misses;
+        small.get(key(10));
+        small.get(key(30));
+        if (small.stats().misses != misses or small.stats().entries != 3)
+            throw logic_error("the cache evicted a recently used plan");
+        small.get(key(20));
+        if (small.stats().misses != misses + 1)
+            throw logic_error("the cache kept the least recently used plan");
+
+        int const   cap     = 4096;
+        int const   nmisses = 20000;
+        PlanCache   full(cap, radix_option, radix_threshold);
+
+        for (int size = 1; size <= cap; ++size)
+            full.get(key(size));
+
+        auto start = steady_clock::now();
+        for (int size = cap + 1; size <= cap + nmisses; ++size)
+            full.get(key(size));
+        double miss_us = duration<double, std::micro>(steady_clock::now() - start).count() / nmisses;
+
+        cout << "eviction in the order of last use: correct, " << setprecision(3) << fixed << miss_us
+             << " us per miss with eviction at " << cap << " plans" << std::defaultfloat << endl;
+    }
 
-            if (use_single_precision)
-                test_speed<complex<float>>(preamble, a, setup_info, use_powers_of_two);
-            else
-                test_speed<complex<double>>(preamble, a, setup_info, use_powers_of_two);
+    {
+        cout << "                 mode  threads    lookups   p50 (us)   p99 (us)   max (us)   lookups/s" << endl;
 
-        } else
-        {
+        for (int mode = 0; mode < 3; ++mode) {
 
-            if (use_single_precision)
-                test_accuracy<complex<float>>(preamble, a, setup_info);
-            else
-                test_accuracy<complex<double>>(preamble, a, setup_info);
+            // 0: plan every call, 1: cache holding all plans, 2: cache holding about a third of them
+            size_t      cap     = mode == 1 ? sizes.size() : sizes.size() / 3;
+            PlanCache   cache(cap, radix_option, radix_threshold);
+
+            vector<vector<double>>  latencies(nthreads);
+            vector<thread>          threads;
+            atomic<long>            wrong_plans{0};
+
+            auto start_time = steady_clock::now();
+
+            for (int t = 0; t < nthreads; ++t)
+            {
+                threads.emplace_back([&, t] {
+                    unsigned    seed        = static_cast<unsigned>(t + 1);
+                    int         precision   = static_cast<int>(sizeof(typename complex_t::value_type));
+                    auto&       latency     = latencies[t];
+
+                    latency.reserve(nlookups);
+
+                    for (int i = 0; i < nlookups; ++i)
+                    {
+                        int     size    = sizes[rand_r(&seed) % sizes.size()];
+                        auto    start   = steady_clock::now();
+
+                        // failures are counted and reported by the main thread, an exception would end the process here
+                        if (mode == 0)
+                        {
+                            FftPlan plan = make_plan(size, radix_option, radix_threshold, FFT_FORWARD, 1, size);
+                            if (plan.size != size)
+                                ++wrong_plans;
+                        }
+                        else if (cache.get(PlanKey{size, precision, FFT_FORWARD, 1, size})->size != size)
+                            ++wrong_plans;
+
+                        latency.push_back(duration<double, std::micro>(steady_clock::now() - start).count());
+                    }
+                });
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+
+            if (wrong_plans > 0)
+                throw logic_error(to_string(wrong_plans.load()) + " lookups returned a plan of the wrong size");
+
+            duration<double> total_s = steady_clock::now() - start_time;
+
+            vector<double> all;
+            for (auto const& latency : latencies)
+                all.insert(all.end(), latency.begin(), latency.end());
+            sort(all.begin(), all.end());
+
+            auto percentile = [&](double p) { return all[static_cast<size_t>(p * static_cast<double>(all.size() - 1))]; };
+
+            char const* const names[] = {"uncached", "cached", "cached, small cap"};
+
+            int const default_precision = static_cast<int>(std::cout.precision());
+            cout << setw(21) << names[mode]
+                    << setw(9) << nthreads
+                    << setw(11) << all.size()
+                    << setw(11) << setprecision(3) << fixed << percentile(0.5)
+                    << setw(11) << setprecision(3) << fixed << percentile(0.99)
+                    << setw(11) << setprecision(3) << fixed << all.back()
+                    << setw(12) << setprecision(0) << fixed << static_cast<double>(all.size()) / total_s.count()
+                    << endl;
+
+            if (mode > 0)
+            {
+                PlanCacheStats stats = cache.stats();
+                cout << "      hits " << stats.hits << ", misses " << stats.misses << ", evictions " << stats.evictions
+                     << ", entries " << stats.entries << endl;
+            }
+            cout << setprecision(default_precision);
+        }
+
+        cout << endl;
+    }
+}
+
+// function that profiles the engines per size: time, peak RSS, scratch memory, cache footprint of the stages
+// and RAPL package energy per transform, written as CSV
+template <typename complex_t>
+void test_profile(string const& text, SetupInfo const& setup_info, bool use_powers_of_2) {
+    using std::chrono::steady_clock;
+    using std::chrono::duration;
+
+    vector<int> sizes;
+    if (use_powers_of_2)
+        for (int size = 64; size <= 32768; size *= 2)
+            sizes.push_back(size);
+    else
+        sizes = {80, 108, 210, 504, 1000, 1960, 4725, 10368, 27000};
+
+    vector<Algorithm> const algorithms = {iterative_breadth_first, recursive_depth_first, split_radix, four_step_parallel, fftw_lib};
+    char const* const       names[]    = {"recursive", "iterative", "fftw", "four-step", "work-stealing", "omp-static", "split-radix"};
+
+    size_t const        element_size    = sizeof(complex_t);
+    size_t const        line_size       = CACHE_LINE_SIZE;
+    double const        min_seconds     = 0.25;
+    bool const          rss_reset       = reset_peak_rss();
+    EnergyCounter       energy;
+    AllocationCounters& counters        = allocation_counters();
+
+    if (not text.empty())
+        cout << "# " << text << endl;
+    if (not rss_reset)
+        cout << "# peak RSS cannot be reset, peak_rss_kb is the peak since the start of the process" << endl;
+    if (not energy.available())
+        cout << "# RAPL package energy is not available (/sys/class/powercap/intel-rapl:*/energy_uj)" << endl;
+
+    cout << "algorithm,precision,radix_option,radix_threshold,threads,size,repetitions,time_ms,peak_rss_kb,scratch_bytes,"
+            "allocated_bytes,stage_footprints,joules_per_transform" << endl;
+
+    for (Algorithm a : algorithms)
+    {
+        // FFTW is double precision, split-radix is for powers of 2
+        if ((a == fftw_lib and element_size != sizeof(complex<double>)) or (a == split_radix and not use_powers_of_2))
+            continue;
+
+        for (int size : sizes)
+        {
+            FftBuffer<complex_t>        in(size);
+            FftBuffer<complex_t>        out;
+            vector<int>                 radices;
+            vector<string>              stage_names;
+            vector<size_t>              footprints;
+            FourStepPlan                four_step_plan;
+            SplitRadixPlan              split_radix_plan;
+            FftBuffer<complex<double>>  fftw_in(size);
+            FftBuffer<complex<double>>  fftw_out(size);
+            fftw_plan                   p = nullptr;
+
+            for (int i = 0; i < size; ++i)
+                in[i] = complex_t(static_cast<typename complex_t::value_type>(sin(i)), static_cast<typename complex_t::value_type>(cos(3 * i)));
+
+            // the engines except FFTW transform in in place, every repetition starts from the same input
+            FftBuffer<complex_t> const original = in;
+
+            switch (a)
+            {
+            case iterative_breadth_first:
+                radices     = compute_radices(size, setup_info.radix_option, setup_info.radix_threshold);
+                footprints  = breadth_first_footprints(radices, element_size);
+                for (int radix : radices)
+                    stage_names.push_back(to_string(radix));
+                break;
+            case recursive_depth_first:
+                radices     = compute_radices(size, setup_info.radix_option, setup_info.radix_threshold);
+                footprints  = depth_first_footprints(radices, element_size, line_size);
+                for (auto radix = radices.rbegin(); radix != radices.rend(); ++radix)
+                    stage_names.push_back(to_string(*radix));
+                break;
+            case split_radix:
+                split_radix_plan    = make_split_radix_plan(size);
+                footprints          = split_radix_footprints(size, element_size, line_size);
+                // levels above 4 split into a half and two quarters, 4 and 2 are the codelets at the leaves
+                for (size_t m = static_cast<size_t>(size), i = 0; i < footprints.size(); m /= 2, ++i)
+                    stage_names.push_back(m > 4 ? "2/4" : to_string(m));
+                break;
+            case four_step_parallel:
+                four_step_plan  = make_four_step_plan(size, setup_info.radix_option, setup_info.radix_threshold, setup_info.nthreads, setup_info.pin_threads);
+                footprints      = four_step_footprints(four_step_plan.n1, four_step_plan.n2, four_step_plan.team->size(), element_size, line_size);
+                stage_names     = {"gather", "n1=" + to_string(four_step_plan.n1), "twiddle", "transpose", "n2=" + to_string(four_step_plan.n2), "scatter"};
+                break;
+            case fftw_lib:
+                p = fftw_plan_dft_1d(size, reinterpret_cast<fftw_complex*>(fftw_in.data()), reinterpret_cast<fftw_complex*>(fftw_out.data()),
+                        FFTW_FORWARD, FFTW_ESTIMATE);
+                copy(in.begin(), in.end(), fftw_in.begin());
+                break;
+            default:
+                break;
+            }
+
+            auto transform = [&]() {
+                switch (a)
+                {
+                case iterative_breadth_first:
+                    out = fft_iterative_breadth_first(in, radices);
+                    break;
+                case recursive_depth_first:
+                    out = fft_recursive_depth_first(in, radices);
+                    break;
+                case split_radix:
+                    out = fft_split_radix(in, split_radix_plan);
+                    break;
+                case four_step_parallel:
+                    fft_four_step_parallel(in, four_step_plan);
+                    break;
+                case fftw_lib:
+                    fftw_execute(p);
+                    break;
+                default:
+                    break;
+                }
+            };
+
+            // warm-up with counting, so that buffers it allocates and later transforms free are counted,
+            // then repetitions for at least min_seconds so that the energy counters advance many times
+            counters.enabled = true;
+            transform();
+
+            reset_peak_rss();
+            counters.reset_peak();
+
+            size_t const    live_before     = counters.live;
+            size_t const    total_before    = counters.total;
+            double const    joules_before   = energy.joules();
+            int             repetitions     = 0;
+            double          elapsed_s       = 0;
+
+            // only the transforms are timed, the energy includes restoring the input (one copy per transform)
+            while (repetitions < REPETITIONS or elapsed_s < min_seconds)
+            {
+                copy(original.begin(), original.end(), in.begin());
+
+                auto const start = steady_clock::now();
+                transform();
+                elapsed_s += duration<double>(steady_clock::now() - start).count();
+                ++repetitions;
+            }
+
+            double const    joules          = energy.joules() - joules_before;
+            size_t const    scratch         = counters.peak - live_before;
+            size_t const    allocated       = (counters.total - total_before) / static_cast<size_t>(repetitions);
+            long const      peak_rss        = peak_rss_kb();
+
+            counters.enabled = false;
+
+            if (p != nullptr)
+                fftw_destroy_plan(p);
+
+            // radix:bytes:cache of every stage in the order of execution
+            ostringstream stages;
+            for (size_t i = 0; i < footprints.size(); ++i)
+                stages << (i == 0 ? "" : " ") << stage_names[i] << ":" << footprints[i] << ":" << cache_level(footprints[i]);
+
+            ostringstream joules_per_transform;
+            if (energy.available())
+                joules_per_transform << joules / repetitions;
+
+            // the memory of FFTW is not allocated through AlignedAllocator
+            cout << names[a] << "," << (element_size == sizeof(complex<float>) ? "single" : "double") << ","
+                    << setup_info.radix_option << ","
+                    << (setup_info.radix_threshold == SetupInfo::not_used ? "" : to_string(setup_info.radix_threshold)) << ","
+                    << (a == four_step_parallel ? setup_info.nthreads : 1) << ","
+                    << size << "," << repetitions << ","
+                    << elapsed_s * 1000 / repetitions << ","
+                    << peak_rss << ","
+                    << (a == fftw_lib ? "" : to_string(scratch)) << ","
+                    << (a == fftw_lib ? "" : to_string(allocated)) << ","
+                    << stages.str() << ","
+                    << joules_per_transform.str()
+                    << endl;
+        }
+    }
+}
+
+// function that measures the rate of planning for many distinct random lengths and the reuse of twiddle tables
+template <typename complex_t>
+void test_planning(string const& text, SetupInfo const& setup_info) {
+    using std::fixed;
+    using std::chrono::steady_clock;
+    using std::chrono::duration;
+
+    int const max_size  = 1 << 22;
+    int const nplans    = 200000;
+
+    int radix_option    = setup_info.radix_option;
+    int radix_threshold = setup_info.radix_threshold == SetupInfo::not_used ? 16 : setup_info.radix_threshold;
+
+    mt19937 generator(42);
+    vector<int> sizes(nplans);
+    for (auto& size : sizes)
+        size = uniform_int_distribution<int>(1, max_size)(generator);
+
+    int const default_bound = factorization_bound();
+
+    cout << text << endl;
+    cout << nplans << " plans of random lengths up to " << max_size << endl;
+    cout << "             factorization   setup (ms)      plans/s" << endl;
+
+    for (int mode = 0; mode < 2; ++mode) {
+
+        // 0: trial division, 1: sieve of smallest prime factors up to the largest length
+        auto start = steady_clock::now();
+        set_factorization_bound(mode == 0 ? 1 : max_size);
+        double setup_ms = duration<double, std::milli>(steady_clock::now() - start).count();
+
+        long checksum = 0;
+        start = steady_clock::now();
+        for (int size : sizes)
+            checksum += static_cast<long>(make_plan(size, radix_option, radix_threshold).radices.size());
+        double elapsed_s = duration<double>(steady_clock::now() - start).count();
+
+        if (checksum <= 0)
+            throw logic_error("no radices");
+
+        char const* const names[] = {"trial division", "sieve"};
+
+        int const default_precision = static_cast<int>(std::cout.precision());
+        cout << setw(26) << names[mode]
+                << setw(13) << setprecision(1) << fixed << setup_ms
+                << setw(13) << setprecision(0) << fixed << nplans / elapsed_s
+                << endl;
+        cout << setprecision(default_precision);
+    }
+
+    set_factorization_bound(default_bound);
+
+    // real plans of distinct even lengths that all stay alive, planning them again finds cached twiddle tables
+    {
+        int const nlive = 8000;
+
+        vector<int> lengths(nlive);
+        for (int i = 0; i < nlive; ++i)
+            lengths[i] = 2 * (i + 1);
+        std::shuffle(lengths.begin(), lengths.end(), generator);
+
+        vector<RealFftPlan> live;
+        live.reserve(nlive);
+        for (int size : lengths)
+            live.push_back(make_real_plan(size, radix_option, radix_threshold));
+
+        auto start = steady_clock::now();
+        for (int r = 0; r < 10; ++r)
+            for (int i = 0; i < nlive; ++i)
+                if (make_real_plan(lengths[i], radix_option, radix_threshold).twiddles.table.use_count() < 2)
+                    throw logic_error("real plan does not share a cached twiddle table");
+        double elapsed_s = duration<double>(steady_clock::now() - start).count();
+
+        cout << "real plans with " << nlive << " plans of distinct lengths alive: "
+             << setprecision(0) << fixed << 10 * nlive / elapsed_s << " plans/s" << std::defaultfloat << endl;
+    }
+
+    // split-radix plans of all powers of 2 up to 2^20, their twiddle tables are views of the largest table while it is alive
+    {
+        auto plan_all = [](bool keep_largest) {
+            SplitRadixPlan largest = make_split_radix_plan(keep_largest ? 1 << 20 : 1);
+            auto start = steady_clock::now();
+            for (int r = 0; r < 10; ++r)
+                for (int size = 1 << 20; size >= 1; size /= 2)
+                    if (make_split_radix_plan(size).twiddles.table == nullptr)
+                        throw logic_error("no twiddle table");
+            return duration<double, std::milli>(steady_clock::now() - start).count() / 10;
+        };
+
+        double separate_ms  = plan_all(false);
+        double shared_ms    = plan_all(true);
+
+        // a split-radix plan holds a quarter table, which serves smaller plans but not a full table of the same size
+        SplitRadixPlan largest = make_split_radix_plan(1 << 20);
+        if (largest.twiddles.table->size() != 1 << 18 or make_split_radix_plan(1 << 12).twiddles.table != largest.twiddles.table
+                or shared_twiddles(1 << 20).table == largest.twiddles.table or shared_twiddles(1 << 20).table->size() != 1 << 20)
+            throw logic_error("wrong sharing of partial twiddle tables");
+
+        cout << "split-radix plans of 2^0 ... 2^20: " << setprecision(3) << fixed << separate_ms << " ms with own twiddle tables, "
+             << shared_ms << " ms with the shared table of 2^20" << std::defaultfloat << endl;
+    }
+
+    cout << endl;
+}
+
+// function that measures the latency of transforms requested concurrently by many client threads,
+// executed synchronously by the clients or asynchronously with and without coalescing
+template <typename complex_t>
+void test_async(string const& text, SetupInfo const& setup_info, bool use_powers_of_2) {
+    using std::fixed;
+    using std::chrono::steady_clock;
+    using std::chrono::duration;
+
+    int const nclients      = 4 * setup_info.nthreads;
+    int const nrequests     = 400;
+
+    cout << text << endl;
+    cout << nclients << " clients with " << nrequests << " requests each, " << setup_info.nthreads << " executor threads" << endl;
+    cout << "  size                 mode   p50 (us)   p90 (us)   p99 (us)   max (us)  transforms/s  batch size" << endl;
+
+    for (int size : use_powers_of_2 ? vector<int>{64, 1024} : vector<int>{60, 1000})
+    {
+        for (int mode = 0; mode < 3; ++mode) {
+
+            // the plan is cached before the measurements
+            {
+                FftBuffer<complex_t> x(size, 1.0);
+                fft_cached(x.data(), size, FFT_FORWARD);
+            }
+
+            // 0: every client transforms itself, 1: executor without coalescing, 2: executor coalescing up to 64 transforms
+            unique_ptr<FftExecutor<complex_t>> executor;
+            if (mode > 0)
+                executor = make_unique<FftExecutor<complex_t>>(setup_info.nthreads, mode == 1 ? 1 : 64);
+
+            vector<vector<double>>  latencies(nclients);
+            vector<thread>          clients;
+            atomic<long>            wrong_transforms{0};
+
+            auto start_time = steady_clock::now();
+
+            for (int t = 0; t < nclients; ++t)
+            {
+                clients.emplace_back([&, t] {
+                    FftBuffer<complex_t>    x(size);
+                    auto&                   latency = latencies[t];
+
+                    latency.reserve(nrequests);
+
+                    for (int i = 0; i < nrequests; ++i)
+                    {
+                        for (int n = 0; n < size; ++n)
+                            x[n] = complex_t(static_cast<typename complex_t::value_type>(t + 1), static_cast<typename complex_t::value_type>(i));
+
+                        auto start = steady_clock::now();
+
+                        try
+                        {
+                            if (mode == 0)
+                                fft_cached(x.data(), size, FFT_FORWARD);
+                            else
+                                executor->submit(x.data(), size, FFT_FORWARD).get();
+                        }
+                        catch (exception const&)
+                        {
+                            ++wrong_transforms;
+                            continue;
+                        }
+
+                        latency.push_back(duration<double, std::micro>(steady_clock::now() - start).count());
+
+                        // the transform of a constant is a single bin
+                        if (abs(x[0] - complex_t(static_cast<typename complex_t::value_type>(size * (t + 1)), static_cast<typename complex_t::value_type>(size * i))) > 1e-3 * size * (t + i + 1))
+                            ++wrong_transforms;
+                    }
+                });
+            }
+
+            for (auto& client : clients)
+                client.join();
+
+            duration<double> total_s = steady_clock::now() - start_time;
+
+            // all bins of a non-constant input, with the future and with the callback, concurrently from all clients
+            if (executor)
+            {
+                vector<int> radices = compute_radices(size, setup_info.radix_option, setup_info.radix_threshold);
+
+                clients.clear();
+                for (int t = 0; t < nclients; ++t)
+                {
+                    clients.emplace_back([&, t] {
+                        FftBuffer<complex_t> x(size), y, z;
+                        for (int n = 0; n < size; ++n)
+                            x[n] = complex_t(static_cast<typename complex_t::value_type>(sin(0.1 * (n + t))), static_cast<typename complex_t::value_type>(cos(0.37 * n * n)));
+                        y = x;
+
+                        // the backward transform of the conjugate is the conjugate of the forward transform
+                        z = FftBuffer<complex_t>(2 * static_cast<size_t>(size));
+                        for (int n = 0; n < size; ++n)
+                            z[n] = z[n + size] = conj(x[n]);
+
+                        FftBuffer<complex_t>    expected            = fft_iterative_breadth_first(x, radices);
+                        auto                    callback_thread     = make_shared<promise<thread::id>>();
+                        future<thread::id>      callback_done       = callback_thread->get_future();
+
+                        try
+                        {
+                            executor->submit(y.data(), size, FFT_FORWARD).get();
+
+                            executor->submit(z.data(), size, FFT_BACKWARD, 2, [callback_thread](exception_ptr e) {
+                                if (e)
+                                    callback_thread->set_exception(e);
+                                else
+                                    callback_thread->set_value(this_thread::get_id());
+                            });
+
+                            // the callback runs on an executor thread
+                            if (callback_done.get() == this_thread::get_id())
+                                ++wrong_transforms;
+                        }
+                        catch (exception const&)
+                        {
+                            ++wrong_transforms;
+                            return;
+                        }
+
+                        double error = 0.0, norm = 0.0;
+                        for (int k = 0; k < size; ++k)
+                        {
+                            error   = max({error, static_cast<double>(abs(y[k] - expected[k])),
+                                       static_cast<double>(abs(conj(z[k]) - expected[k])), static_cast<double>(abs(conj(z[k + size]) - expected[k]))});
+                            norm    = max(norm, static_cast<double>(abs(expected[k])));
+                        }
+
+                        if (error > 100 * numeric_limits<typename complex_t::value_type>::epsilon() * log2(size) * norm)
+                            ++wrong_transforms;
+                    });
+                }
+
+                for (auto& client : clients)
+                    client.join();
+            }
+
+            if (wrong_transforms > 0)
+                throw logic_error(to_string(wrong_transforms.load()) + " asynchronous transforms are wrong");
+
+            vector<double> all;
+            for (auto const& latency : latencies)
+                all.insert(all.end(), latency.begin(), latency.end());
+            sort(all.begin(), all.end());
+
+            auto percentile = [&](double p) { return all[static_cast<size_t>(p * static_cast<double>(all.size() - 1))]; };
+
+            double batch_size = 1.0;
+            if (executor)
+            {
+                FftExecutorStats stats = executor->stats();
+                batch_size = static_cast<double>(stats.transforms) / static_cast<double>(stats.batches);
+            }
+
+            char const* const names[] = {"synchronous", "async", "async, coalescing"};
+
+            int const default_precision = static_cast<int>(std::cout.precision());
+            cout << setw(6) << size
+                    << setw(21) << names[mode]
+                    << setw(11) << setprecision(1) << fixed << percentile(0.5)
+                    << setw(11) << setprecision(1) << fixed << percentile(0.9)
+                    << setw(11) << setprecision(1) << fixed << percentile(0.99)
+                    << setw(11) << setprecision(1) << fixed << all.back()
+                    << setw(14) << setprecision(0) << fixed << static_cast<double>(all.size()) / total_s.count()
+                    << setw(12) << setprecision(2) << fixed << batch_size
+                    << endl;
+            cout << setprecision(default_precision);
+        }
+    }
+
+    cout << endl;
+}
+
+// function that checks all engines, radix options, precisions and directions over many sizes against a
+// long double reference transform: the relative RMS error ||y - y_ref|| / ||y_ref|| must not exceed
+// bound_factor * eps * (log2 N + sum of the radices / 4), throws if any transform exceeds it
+void test_accuracy_suite(string const& text, SetupInfo const& setup_info, int max_size) {
+    using std::fixed;
+    using std::chrono::steady_clock;
+    using std::chrono::duration;
+
+    enum SuiteEngine {iterative, recursive, four_step, work_stealing, omp_static, backward_plan, chirp_z, shared_table, split, fftw};
+    char const* const engine_names[] = {"iterative", "recursive", "four-step", "work-stealing", "OpenMP static", "backward plan", "chirp-z", "shared table", "split-radix", "FFTW"};
+
+    // Bound of the relative RMS error: c eps (log2 N + sum of r / 4 over the radices r).
+    // Stages with radices 2 and 4 give the O(eps log2 N) error of the textbook analysis.
+    // A radix-r butterfly is an r-point DFT by Horner's scheme, its j-th term is multiplied by the j-th power
+    // of a rounded root of unity and has the relative error j u (u = eps / 2), the RMS over the terms is
+    // r u / sqrt(3) < r eps / 4; this O(r^2) butterfly, not log2 r, dominates for large prime radices.
+    // Measured errors are at most 0.13 eps per radix-2 level and 0.11 r eps per prime radix, c = 2 leaves
+    // a margin of at least 2 (4 for large radices) against random fluctuations.
+    double const    bound_factor    = 2.0;
+    int const       inner_threads   = 2;
+    int const       threshold       = setup_info.radix_threshold == SetupInfo::not_used ? 16 : setup_info.radix_threshold;
+
+    // all sizes up to 1024, the 7-smooth sizes and random sizes with prime factors up to 101
+    vector<int> sizes;
+    for (int n = 1; n <= min(max_size, 1024); ++n)
+        sizes.push_back(n);
+
+    for (long long p2 = 1; p2 <= max_size; p2 *= 2)
+        for (long long p3 = p2; p3 <= max_size; p3 *= 3)
+            for (long long p5 = p3; p5 <= max_size; p5 *= 5)
+                for (long long p7 = p5; p7 <= max_size; p7 *= 7)
+                    if (p7 > 1024)
+                        sizes.push_back(static_cast<int>(p7));
+
+    auto largest_prime_factor = [](int n) {
+        int largest = 1;
+        for (int p = 2; p * p <= n; ++p)
+            while (n % p == 0)
+            {
+                largest = p;
+                n /= p;
+            }
+        return max(largest, n);
+    };
+
+    mt19937 generator(2024);
+    for (int count = 0; count < 256 and max_size > 1024; )
+    {
+        int n = uniform_int_distribution<int>(1025, max_size)(generator);
+        if (largest_prime_factor(n) <= 101)
+        {
+            sizes.push_back(n);
+            ++count;
+        }
+    }
+
+    sort(sizes.begin(), sizes.end());
+    sizes.erase(unique(sizes.begin(), sizes.end()), sizes.end());
+
+    // one configuration per precision, engine and radix option, split-radix without radices and FFTW only in double precision
+    struct Config
+    {
+        bool        single;
+        SuiteEngine engine;
+        int         option;
+    };
+
+    vector<Config> configs;
+    for (bool single : {false, true})
+        for (SuiteEngine engine : {iterative, recursive, four_step, work_stealing, omp_static, backward_plan, chirp_z, shared_table})
+            for (int option : {1, 2, 3})
+                configs.push_back(Config{single, engine, option});
+    configs.push_back(Config{false, split, 0});
+    configs.push_back(Config{true, split, 0});
+    configs.push_back(Config{false, fftw, 0});
+
+    struct Result
+    {
+        double  error;      // relative RMS error
+        double  bound;      // 0 if the engine does not transform the size
+    };
+
+    vector<vector<Result>>  results(configs.size(), vector<Result>(sizes.size()));
+    mutex                   fftw_mutex;
+
+    auto error_terms = [](int n, vector<int> const& radices) {
+        double terms = max(1.0, log2(static_cast<double>(n)));
+        for (int radix : radices)
+            terms += radix / 4.0;
+        return terms;
+    };
+
+    auto relative_rms = [](auto const& y, FftBuffer<complex<long double>> const& reference) {
+        long double diff = 0.0L, norm = 0.0L;
+        for (size_t k = 0; k < reference.size(); ++k)
+        {
+            diff += std::norm(complex<long double>(y[k]) - reference[k]);
+            norm += std::norm(reference[k]);
+        }
+        return norm > 0.0L ? static_cast<double>(sqrt(diff / norm)) : static_cast<double>(sqrt(diff));
+    };
+
+    auto run = [&](auto precision, Config const& config, FftBuffer<complex<long double>> const& x, WorkStealingPool& pool) {
+        using complex_t = decltype(precision);
+
+        int                     n       = static_cast<int>(x.size());
+        FftBuffer<complex_t>    in(x.begin(), x.end());
+        FftBuffer<complex_t>    out(n);
+        FftBuffer<complex_t>    work;
+        vector<int>             radices = config.engine == fftw or config.engine == split ? vector<int>{} : compute_radices(n, config.option, threshold);
+        double                  stages  = error_terms(n, radices);
+        FourStepPlan            four_step_plan;
+        FftPlan                 plan;
+        ChirpZPlan              chirp_z_plan;
+
+        switch (config.engine)
+        {
+        case iterative:
+            out = fft_iterative_breadth_first(in, radices);
+            break;
+        case recursive:
+            out = fft_recursive_depth_first(in, radices);
+            break;
+        case four_step:
+            four_step_plan = make_four_step_plan(n, config.option, threshold, inner_threads);
+            fft_four_step_parallel(in, four_step_plan);
+            out = in;
+            break;
+        case work_stealing:
+            out = fft_recursive_depth_first_tasks(in, radices, pool, setup_info.grain_size);
+            break;
+        case omp_static:
+            out = fft_recursive_depth_first_omp(in, radices, inner_threads);
+            break;
+        case backward_plan:
+            plan = make_plan(n, config.option, threshold, FFT_BACKWARD, 1, n);
+            execute_batch(plan, in.data(), out.data(), 1, n, 1, work);
+            break;
+        case chirp_z:
+            // two transforms of the convolution length and the chirp multiplications
+            chirp_z_plan    = make_bluestein_plan(n, config.option, threshold);
+            radices         = compute_radices(chirp_z_plan.conv_size, config.option, threshold);
+            stages          = 2 * error_terms(chirp_z_plan.conv_size, radices) + 4;
+            execute_chirp_z(chirp_z_plan, in.data(), out.data(), work);
+            break;
+        case shared_table:
+            out = fft_iterative_breadth_first(in, radices, shared_twiddles(n));
+            break;
+        case split:
+            // radix-2 and radix-4 butterflies with precomputed twiddles
+            out     = fft_split_radix(in, make_split_radix_plan(n));
+            stages  = max(1.0, log2(static_cast<double>(n)));
+            break;
+        case fftw:
+            {
+                // only the execution of FFTW plans is thread safe
+                FftBuffer<complex<double>> fftw_in(x.begin(), x.end()), fftw_out(n);
+                fftw_plan p;
+                {
+                    lock_guard<mutex> lock(fftw_mutex);
+                    p = fftw_plan_dft_1d(n, reinterpret_cast<fftw_complex*>(fftw_in.data()), reinterpret_cast<fftw_complex*>(fftw_out.data()), FFTW_FORWARD, FFTW_ESTIMATE);
+                }
+                fftw_execute(p);
+                {
+                    lock_guard<mutex> lock(fftw_mutex);
+                    fftw_destroy_plan(p);
+                }
+                out.assign(fftw_out.begin(), fftw_out.end());
+                stages = max(1.0, log2(static_cast<double>(n)));
+            }
+            break;
+        }
+
+        return make_pair(out, static_cast<double>(numeric_limits<typename complex_t::value_type>::epsilon()) * max(stages, 1.0));
+    };
+
+    cout << text << endl;
+    cout << sizes.size() << " sizes up to " << max_size << ", " << configs.size() << " configurations, threshold " << threshold
+         << " for thresholded radices, " << setup_info.nthreads << " threads" << endl;
+
+    auto start = steady_clock::now();
+
+    // the sizes are distributed dynamically over the threads, each size is checked in all configurations
+    atomic<size_t>  next_size{0};
+    vector<thread>  threads;
+
+    for (int t = 0; t < setup_info.nthreads; ++t)
+        threads.emplace_back([&] {
+            WorkStealingPool pool(inner_threads);
+
+            for (size_t s = next_size++; s < sizes.size(); s = next_size++)
+            {
+                int n = sizes[s];
+
+                // inputs representable in single precision, so that both precisions transform the same data
+                mt19937 input_generator(static_cast<unsigned>(n));
+                uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+                FftBuffer<complex<long double>> x(n);
+                for (auto& v : x)
+                {
+                    float re = uniform(input_generator);
+                    v = complex<long double>(re, uniform(input_generator));
+                }
+
+                FftBuffer<complex<long double>> forward     = reference_fft(x, FFT_FORWARD);
+                FftBuffer<complex<long double>> backward    = reference_fft(x, FFT_BACKWARD);
+
+                for (size_t c = 0; c < configs.size(); ++c)
+                {
+                    Config const&                           config      = configs[c];
+                    FftBuffer<complex<long double>> const&  reference   = config.engine == backward_plan ? backward : forward;
+
+                    if (config.engine == split and (n & (n - 1)) != 0)
+                    {
+                        results[c][s] = Result{0.0, 0.0};
+                        continue;
+                    }
+
+                    if (config.single)
+                    {
+                        auto [y, scale] = run(complex<float>{}, config, x, pool);
+                        results[c][s]   = Result{relative_rms(y, reference), bound_factor * scale};
+                    }
+                    else
+                    {
+                        auto [y, scale] = run(complex<double>{}, config, x, pool);
+                        results[c][s]   = Result{relative_rms(y, reference), bound_factor * scale};
+                    }
+                }
+            }
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    double elapsed_s = duration<double>(steady_clock::now() - start).count();
+
+    // errors in units of eps log2 N, the normalization of the textbook bound
+    cout << "precision  engine          radices        median    max (eps log2 N)  max / bound  at size  failures" << endl;
+
+    int total_failures = 0;
+    vector<string> failures;
+
+    for (size_t c = 0; c < configs.size(); ++c)
+    {
+        Config const&   config  = configs[c];
+        double          eps     = config.single ? numeric_limits<float>::epsilon() : numeric_limits<double>::epsilon();
+        vector<double>  normalized;
+        double          worst_ratio = 0.0;
+        int             worst_size  = 0;
+        int             nfailures   = 0;
+
+        for (size_t s = 0; s < sizes.size(); ++s)
+        {
+            Result const& r = results[c][s];
+
+            if (r.bound == 0.0)
+                continue;
+
+            normalized.push_back(r.error / (eps * max(1.0, log2(static_cast<double>(sizes[s])))));
+
+            if (r.error / r.bound > worst_ratio)
+            {
+                worst_ratio = r.error / r.bound;
+                worst_size  = sizes[s];
+            }
+
+            if (r.error > r.bound)
+            {
+                ++nfailures;
+                ostringstream line;
+                line << (config.single ? "single " : "double ") << engine_names[config.engine] << " option " << config.option
+                     << " size " << sizes[s] << ": " << scientific << setprecision(2) << r.error << " > " << r.bound;
+                failures.push_back(line.str());
+            }
+        }
+
+        sort(normalized.begin(), normalized.end());
+        total_failures += nfailures;
+
+        char const* const option_names[] = {"-", "factors", "reversed", "thresholded"};
+
+        int const default_precision = static_cast<int>(std::cout.precision());
+        cout << std::left << setw(11) << (config.single ? "single" : "double")
+                << setw(16) << engine_names[config.engine]
+                << setw(12) << option_names[config.option] << std::right
+                << setw(9) << setprecision(3) << fixed << normalized[normalized.size() / 2]
+                << setw(20) << setprecision(3) << fixed << normalized.back()
+                << setw(13) << setprecision(3) << fixed << worst_ratio
+                << setw(9) << worst_size
+                << setw(10) << nfailures
+                << endl;
+        cout << setprecision(default_precision) << std::defaultfloat;
+    }
+
+    for (size_t i = 0; i < min<size_t>(failures.size(), 20); ++i)
+        cout << "exceeds bound: " << failures[i] << endl;
+
+    long ntransforms = 0;
+    for (auto const& config_results : results)
+        ntransforms += count_if(config_results.begin(), config_results.end(), [](Result const& r) { return r.bound > 0.0; });
+    if (total_failures == 0)
+        cout << "all " << ntransforms << " transforms within bounds";
+    else
+        cout << total_failures << " of " << ntransforms << " transforms exceed the bound";
+    cout << " (" << setprecision(1) << fixed << elapsed_s << " s)" << std::defaultfloat << endl;
+
+    cout << endl;
+
+    if (total_failures > 0)
+        throw runtime_error("accuracy suite: " + to_string(total_failures) + " transforms exceed the error bound");
+}
+
+// function that compares the fused spectral operations with a transform followed by separate passes
+template <typename complex_t>
+void test_spectral(string const& text, SetupInfo const& setup_info, bool use_powers_of_2) {
+    using std::fixed;
+    using std::chrono::steady_clock;
+    using std::chrono::duration;
+    using real_t = typename complex_t::value_type;
+
+    int const size      = use_powers_of_2 ? 4096 : 4000;
+    int const howmany   = 64;
+    int const total     = size * howmany;
+
+    // best of three runs in milliseconds
+    auto time_ms = [](auto const& run) {
+        double best = numeric_limits<double>::max();
+        for (int r = 0; r < 3; ++r)
+        {
+            auto start = steady_clock::now();
+            run();
+            best = min(best, duration<double, std::milli>(steady_clock::now() - start).count());
+        }
+        return best;
+    };
+
+    auto max_relative = [](auto const& a, auto const& b) {
+        double diff = 0.0, norm = 0.0;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            diff = max(diff, static_cast<double>(abs(a[i] - b[i])));
+            norm = max(norm, static_cast<double>(abs(b[i])));
+        }
+        return norm > 0.0 ? diff / norm : diff;
+    };
+
+    // 16-bit IQ samples as delivered by a receiver, a Hann window and a reference spectrum
+    vector<complex<short>> in(total);
+    for (int i = 0; i < total; ++i)
+        in[i] = complex<short>(static_cast<short>(8000 * sin(0.05 * i) + 1000 * sin(7.3 * i)),
+                               static_cast<short>(8000 * cos(0.05 * i) + 1000 * cos(11.9 * i)));
+
+    FftBuffer<real_t> window(size);
+    for (int n = 0; n < size; ++n)
+        window[n] = static_cast<real_t>(0.5 - 0.5 * cos(2 * PI * n / size));
+
+    FftPlan                 plan = make_plan(size, setup_info.radix_option, setup_info.radix_threshold, FFT_FORWARD, 1, size);
+    FftBuffer<complex_t>    reference(size);
+    FftBuffer<complex_t>    work;
+    for (int n = 0; n < size; ++n)
+        reference[n] = complex_t(static_cast<real_t>(in[n].real()), static_cast<real_t>(in[n].imag()));
+    execute_batch(plan, reference.data(), 1, work);
+
+    // separate passes: convert and window, transform in place, then the operation on the spectrum
+    FftBuffer<complex_t> spectrum(total);
+    auto transform = [&] {
+        for (int b = 0; b < howmany; ++b)
+            for (int n = 0; n < size; ++n)
+            {
+                complex<short> const& s = in[b * size + n];
+                spectrum[b * size + n] = complex_t(static_cast<real_t>(s.real()) * window[n], static_cast<real_t>(s.imag()) * window[n]);
+            }
+        execute_batch(plan, spectrum.data(), howmany, work);
+    };
+
+    FftBuffer<complex_t>    separate_complex(total), fused_complex(total);
+    FftBuffer<real_t>       separate_real(total), fused_real(total);
+
+    cout << text << endl;
+    cout << "size " << size << ", " << howmany << " blocks of 16-bit IQ samples, Hann window" << endl;
+    cout << "operation           separate (ms)  fused (ms)  rel. difference" << endl;
+
+    auto report = [&](char const* name, double separate_ms, double fused_ms, double difference) {
+        int const default_precision = static_cast<int>(std::cout.precision());
+        cout << std::left << setw(18) << name << std::right
+             << setw(15) << setprecision(2) << fixed << separate_ms
+             << setw(12) << setprecision(2) << fixed << fused_ms
+             << setw(17) << setprecision(2) << scientific << difference
+             << endl;
+        cout << setprecision(default_precision) << std::defaultfloat;
+    };
+
+    {
+        double separate_ms  = time_ms([&] { transform(); copy(spectrum.begin(), spectrum.end(), separate_complex.begin()); });
+        double fused_ms     = time_ms([&] { windowed_transform(plan, in.data(), window.data(), real_t(1), fused_complex.data(), howmany, work); });
+        report("windowed", separate_ms, fused_ms, max_relative(fused_complex, separate_complex));
+    }
+
+    {
+        double separate_ms  = time_ms([&] {
+            transform();
+            for (int i = 0; i < total; ++i)
+                separate_real[i] = norm(spectrum[i]);
+        });
+        double fused_ms     = time_ms([&] { power_spectrum(plan, in.data(), window.data(), fused_real.data(), howmany, work); });
+        report("power", separate_ms, fused_ms, max_relative(fused_real, separate_real));
+    }
+
+    {
+        real_t const floor = numeric_limits<real_t>::min();
+        double separate_ms  = time_ms([&] {
+            transform();
+            for (int i = 0; i < total; ++i)
+                separate_real[i] = real_t(10) * log10(max(norm(spectrum[i]), floor));
+        });
+        double fused_ms     = time_ms([&] { log_power_spectrum(plan, in.data(), window.data(), fused_real.data(), howmany, work, floor); });
+        report("log power", separate_ms, fused_ms, max_relative(fused_real, separate_real));
+    }
+
+    {
+        double separate_ms  = time_ms([&] {
+            transform();
+            for (int b = 0; b < howmany; ++b)
+                for (int k = 0; k < size; ++k)
+                    separate_complex[b * size + k] = spectrum[b * size + k] * conj(reference[k]);
+        });
+        double fused_ms     = time_ms([&] { cross_spectrum(plan, in.data(), window.data(), reference.data(), fused_complex.data(), howmany, work); });
+        report("cross", separate_ms, fused_ms, max_relative(fused_complex, separate_complex));
+    }
+
+    cout << endl;
+}
+
+// function that compares transforms of awkward lengths with transforms of the next fast length and chirp-z transforms
+template <typename complex_t>
+void test_sizes(string const& text, SetupInfo const& setup_info) {
+    using std::fixed;
+    using std::chrono::steady_clock;
+    using std::chrono::duration;
+
+    int radix_option    = setup_info.radix_option;
+    int radix_threshold = setup_info.radix_threshold;
+
+    // best of three runs in milliseconds
+    auto time_ms = [](auto const& transform) {
+        double best = numeric_limits<double>::max();
+        for (int r = 0; r < 3; ++r)
+        {
+            auto start = steady_clock::now();
+            transform();
+            best = min(best, duration<double, std::milli>(steady_clock::now() - start).count());
+        }
+        return best;
+    };
+
+    SizeCostModel model = measure_cost_model(radix_option, radix_threshold);
+
+    cout << text << endl;
+    cout << "cost model: " << model.stage_cost << " ns per element and stage + " << model.radix_cost << " ns per element and radix" << endl;
+    cout << "   size  fast size   exact (ms)   padded (ms)  chirp-z (ms)  rel. difference" << endl;
+
+    for (int size : {1000, 4725, 10007, 165375})
+    {
+
+        int fast_size = next_fast_size(size, radix_option, radix_threshold, model);
+
+        FftBuffer<complex_t>    in(size);
+        for (int i = 0; i < size; ++i)
+            in[i] = complex_t(static_cast<typename complex_t::value_type>(sin(i)), static_cast<typename complex_t::value_type>(cos(3 * i)));
+
+        vector<int>             radices = compute_radices(size, radix_option, radix_threshold);
+        FftBuffer<complex_t>    exact;
+        double exact_ms = time_ms([&] { exact = in; fft_iterative_breadth_first(exact, radices); });
+
+        vector<int>             fast_radices = compute_radices(fast_size, radix_option, radix_threshold);
+        FftBuffer<complex_t>    padded;
+        double padded_ms = time_ms([&] { padded.assign(fast_size, 0.0); copy(in.begin(), in.end(), padded.begin()); fft_iterative_breadth_first(padded, fast_radices); });
+
+        ChirpZPlan              plan = make_bluestein_plan(size, radix_option, radix_threshold);
+        FftBuffer<complex_t>    chirp_z(size);
+        FftBuffer<complex_t>    work;
+        double chirp_z_ms = time_ms([&] { execute_chirp_z(plan, in.data(), chirp_z.data(), work); });
+
+        int const default_precision = static_cast<int>(std::cout.precision());
+        cout << setw(7) << size
+                << setw(11) << fast_size
+                << setw(13) << setprecision(2) << fixed << exact_ms
+                << setw(14) << setprecision(2) << fixed << padded_ms
+                << setw(14) << setprecision(2) << fixed << chirp_z_ms
+                << setw(17) << setprecision(2) << scientific << max_norm(chirp_z - exact) / max_norm(exact)
+                << endl;
+        cout << setprecision(default_precision) << std::defaultfloat;
+
+    }
+
+    // 64 bins of a zoomed band at an eighth of the bin spacing against the direct sum
+    {
+        int const           size    = 2000;
+        int const           nbins   = 64;
+        long double const   start   = 0.1L;
+        long double const   step    = 1.0L / (8 * size);
+
+        TestInstance<complex_t> test_instance = generate_test_instance<complex_t>(size, 11);
+        ChirpZPlan              plan = make_chirp_z_plan(size, nbins, start, step, radix_option, radix_threshold);
+        FftBuffer<complex_t>    zoomed(nbins);
+        FftBuffer<complex_t>    work;
+
+        execute_chirp_z(plan, test_instance.in.data(), zoomed.data(), work);
+
+        FftBuffer<complex_t> expected(nbins);
+        for (int k = 0; k < nbins; ++k)
+        {
+            complex<long double> y = 0.0;
+            for (int n = 0; n < size; ++n)
+                y += complex<long double>(test_instance.in[n]) * polar(1.0L, -2 * PI * n * (start + k * step));
+            expected[k] = static_cast<complex_t>(y);
+        }
+
+        cout << "zoom: " << nbins << " bins from " << static_cast<double>(start) << " cycles per sample in steps of 1/" << 8 * size
+             << ", max error " << scientific << setprecision(2) << max_norm(zoomed - expected) << std::defaultfloat << endl;
+    }
+
+    cout << endl;
+}
+
+// function that compares the sliding DFT with a full transform of the window after every hop
+template <typename complex_t>
+void test_sliding(string const& text, SetupInfo const& setup_info, bool use_powers_of_2) {
+    using std::fixed;
+    using std::chrono::steady_clock;
+    using std::chrono::duration;
+
+    int const size      = use_powers_of_2 ? 1024 : 1000;
+    int const nsamples  = 1 << 14;
+
+    struct SlidingCase
+    {
+        int     hop;
+        int     nbins;
+        int     reanchor_interval;
+    };
+    vector<SlidingCase> const cases = {
+        {1, 0, 0}, {1, 0, numeric_limits<int>::max()}, {16, 0, 0}, {256, 0, 0},
+        {1, 4, 0}, {16, 4, 0}, {256, 4, 0}
+    };
+
+    TestInstance<complex_t> stream = generate_test_instance<complex_t>(nsamples, 7);
+
+    FftPlan full_plan = make_plan(size, setup_info.radix_option, setup_info.radix_threshold);
+
+    // exact spectrum of the last window
+    FftBuffer<complex<long double>> last_window(stream.in.end() - size, stream.in.end());
+    FftBuffer<complex<long double>> expected = dft_matrix_mult(last_window);
+
+    cout << text << endl;
+    cout << "  size   hop  bins   re-anchor     mode  sliding (us)  full (us)  speedup  max error" << endl;
+
+    for (auto const& c : cases)
+    {
+
+        vector<int> bins;
+        for (int i = 0; i < c.nbins; ++i)
+            bins.push_back((i + 1) * size / (c.nbins + 2));
+
+        SlidingDft<complex_t> sliding_dft(size, c.hop, bins, setup_info.radix_option, setup_info.radix_threshold, c.reanchor_interval);
+
+        auto start = steady_clock::now();
+        for (auto const& sample : stream.in)
+            sliding_dft.push(sample);
+        double sliding_us = duration<double, std::micro>(steady_clock::now() - start).count() / nsamples;
+
+        // recompute all bins from the window after every hop, timed for at most 64 hops
+        int const               nhops   = min(nsamples / c.hop, 64);
+        FftBuffer<complex_t>    work(size);
+        start = steady_clock::now();
+        for (int t = c.hop; t <= nhops * c.hop; t += c.hop)
+        {
+            fill(work.begin(), work.end(), complex_t(0.0));
+            int first = max(0, t - size);
+            copy(stream.in.begin() + first, stream.in.begin() + t, work.end() - (t - first));
+            fft_iterative_breadth_first(work, full_plan.radices);
+        }
+        double full_us = duration<double, std::micro>(steady_clock::now() - start).count() / (nhops * c.hop);
+
+        double max_error = 0.0;
+        for (size_t i = 0; i < sliding_dft.tracked_bins().size(); ++i)
+            max_error = max(max_error, static_cast<double>(abs(complex<long double>(sliding_dft.spectrum()[i]) - expected[sliding_dft.tracked_bins()[i]])));
+
+        int const default_precision = static_cast<int>(std::cout.precision());
+        cout << setw(6) << size
+                << setw(6) << c.hop
+                << setw(6) << sliding_dft.tracked_bins().size()
+                << setw(12) << (c.reanchor_interval == 0 ? to_string(size) : string("never"))
+                << setw(9) << (sliding_dft.is_sliding() ? "sliding" : "hopping")
+                << setw(14) << setprecision(3) << fixed << sliding_us
+                << setw(11) << setprecision(3) << fixed << full_us
+                << setw(9) << setprecision(1) << fixed << full_us / sliding_us
+                << setw(11) << setprecision(2) << scientific << max_error
+                << endl;
+        cout << setprecision(default_precision) << std::defaultfloat;
+
+    }
+
+    cout << endl;
+}
+
+// function that tests the accuracy of the DCTs and DSTs against the direct formulas
+template <typename complex_t>
+void test_trig(string const& text, SetupInfo const& setup_info) {
+    using std::fixed;
+    using std::chrono::high_resolution_clock;
+    using std::chrono::duration;
+
+    using real_t = typename complex_t::value_type;
+
+    vector<int> const       sizes = {2 * 2 * 2 * 3 * 5 * 7, 3 * 5 * 11 * 13, 2 * 2 * 2 * 2 * 3 * 37, 4096, 2};
+    vector<TrigKind> const  kinds = {TrigKind::dct1, TrigKind::dct2, TrigKind::dct3, TrigKind::dct4,
+                                     TrigKind::dst1, TrigKind::dst2, TrigKind::dst3, TrigKind::dst4};
+
+    cout << text << endl;
+
+    {
+        cout << "     kind  size   time (ms)  accuracy (max-norm)   accuracy (two-norm)" << endl;
+
+        for (TrigKind kind : kinds) {
+            for (int size : sizes) {
+
+                srand(43);
+                vector<real_t> in(size);
+                for (auto& x : in)
+                    x = static_cast<real_t>(static_cast<double>(rand()) / RAND_MAX);
+
+                vector<real_t>          expected = trig_matrix_mult(kind, in);
+                vector<real_t>          out(size);
+                FftBuffer<complex_t>    work;
+                TrigPlan                plan = make_trig_plan(kind, size, setup_info.radix_option, setup_info.radix_threshold);
+
+                auto start_time_ms = high_resolution_clock::now();
+                execute_trig(plan, in.data(), out.data(), work);
+                duration<double, std::milli> duration_ms = high_resolution_clock::now() - start_time_ms;
+
+                real_t max_error    = 0.0;
+                real_t sum_squares  = 0.0;
+                for (int k = 0; k < size; ++k)
+                {
+                    max_error   = max(max_error, abs(out[k] - expected[k]));
+                    sum_squares += (out[k] - expected[k]) * (out[k] - expected[k]);
+                }
+
+                int const default_precision = static_cast<int>(std::cout.precision());
+                cout << setw(9) << trig_kind_name(kind)
+                        << setw(6) << size
+                        << setw(12) << setprecision(2) << fixed << duration_ms.count()
+                        << setw(21) << fixed << setprecision(12) << max_error
+                        << setw(22) << fixed << setprecision(12) << sqrt(sum_squares)
+                        << endl;
+                cout << setprecision(default_precision);
+            }
+        }
+
+        cout << endl;
+    }
+}
+
+// function that compares pruned transforms of zero-padded inputs and bin ranges with the full transform
+template <typename complex_t>
+void test_pruned(string const& text, SetupInfo const& setup_info, bool use_powers_of_2) {
+    using std::fixed;
+    using std::chrono::steady_clock;
+    using std::chrono::duration;
+
+    int const size = use_powers_of_2 ? 1 << 12 : 3600;
+
+    // nonzero inputs and requested bins as fractions of the size
+    struct PruningCase
+    {
+        int     input_fraction;
+        int     bin_fraction;
+        int     nbins;
+    };
+    vector<PruningCase> const cases = {
+        {2, 1, 0}, {8, 1, 0}, {64, 1, 0},
+        {1, 2, 0}, {1, 8, 0}, {1, 64, 0},
+        {8, 64, 0}, {1, 0, 4}, {1, 0, 1}
+    };
+
+    int radix_option    = setup_info.radix_option;
+    int radix_threshold = setup_info.radix_threshold;
+
+    FftPlan full_plan = make_plan(size, radix_option, radix_threshold);
+
+    cout << text << endl;
+    cout << "  size    inputs      bins      mode  pruned (us)   full (us)  speedup  max error" << endl;
+
+    for (auto const& c : cases)
+    {
+
+        int m           = size / c.input_fraction;
+        int nbins       = c.nbins > 0 ? c.nbins : size / c.bin_fraction;
+        int first_bin   = (size - nbins) / 3;
+        int last_bin    = first_bin + nbins;
+
+        TestInstance<complex_t> test_instance = generate_test_instance<complex_t>(m, 1);
+
+        FftBuffer<complex<long double>> padded(size, 0.0);
+        copy(test_instance.in.begin(), test_instance.in.end(), padded.begin());
+        FftBuffer<complex<long double>> reference_ld = dft_matrix_mult(padded);
+        FftBuffer<complex_t>            reference(reference_ld.begin() + first_bin, reference_ld.begin() + last_bin);
+
+        PrunedPlan              plan = make_pruned_plan(size, m, first_bin, last_bin, radix_option, radix_threshold);
+        FftBuffer<complex_t>    out(nbins);
+        FftBuffer<complex_t>    work;
+        FftBuffer<complex_t>    columns;
+        FftBuffer<complex_t>    full;
+
+        double pruned_us    = numeric_limits<double>::max();
+        double full_us      = numeric_limits<double>::max();
+
+        for (int r = 0; r < REPETITIONS; ++r)
+        {
+
+            auto start = steady_clock::now();
+            fft_pruned(plan, test_instance.in.data(), out.data(), work, columns);
+            pruned_us = min(pruned_us, duration<double, std::micro>(steady_clock::now() - start).count());
+
+            start = steady_clock::now();
+            full.assign(size, 0.0);
+            copy(test_instance.in.begin(), test_instance.in.end(), full.begin());
+            fft_iterative_breadth_first(full, full_plan.radices);
+            full_us = min(full_us, duration<double, std::micro>(steady_clock::now() - start).count());
+
+        }
+
+        int const default_precision = static_cast<int>(std::cout.precision());
+        cout << setw(6) << size
+                << setw(10) << m
+                << setw(10) << nbins
+                << setw(10) << pruning_mode_name(plan.mode)
+                << setw(13) << setprecision(1) << fixed << pruned_us
+                << setw(12) << setprecision(1) << fixed << full_us
+                << setw(9) << setprecision(1) << fixed << full_us / pruned_us
+                << setw(11) << setprecision(2) << scientific << max_norm(out - reference)
+                << endl;
+        cout << setprecision(default_precision) << std::defaultfloat;
+
+    }
+
+    cout << endl;
+}
+
+// time and check the compile-time FFT of size N against the runtime plan on the same batch
+template <typename complex_t, size_t N>
+void test_fixed_size_instance(SetupInfo const& setup_info) {
+    using std::fixed;
+    using std::chrono::steady_clock;
+    using std::chrono::duration;
+
+    int const   nblocks = 1024;
+    int const   size    = static_cast<int>(N);
+
+    vector<array<complex_t, N>>     fixed_in(nblocks);
+    vector<array<complex_t, N>>     fixed_out(nblocks);
+    FftBuffer<complex_t>            runtime_data(static_cast<size_t>(nblocks) * N);
+    FftBuffer<complex_t>            work;
+
+    for (int b = 0; b < nblocks; ++b)
+    {
+        TestInstance<complex_t> test_instance = generate_test_instance<complex_t>(size, b);
+        copy(test_instance.in.begin(), test_instance.in.end(), fixed_in[b].begin());
+    }
+
+    // accuracy of both paths against the matrix multiplication in long double
+    FftPlan plan = make_plan(size, setup_info.radix_option, setup_info.radix_threshold);
+
+    TestInstance<complex_t> test_instance = generate_test_instance<complex_t>(size, 0);
+    array<complex_t, N>     fixed_result = fft(fixed_in[0]);
+    FftBuffer<complex_t>    runtime_result(fixed_in[0].begin(), fixed_in[0].end());
+    execute_batch(plan, runtime_result.data(), 1, work);
+
+    double fixed_error      = max_norm(FftBuffer<complex_t>(fixed_result.begin(), fixed_result.end()) - test_instance.out);
+    double runtime_error    = max_norm(runtime_result - test_instance.out);
+
+    // repeat both until each has run for at least 0.2 s
+    auto time_per_transform = [&](auto const& transform_batch) {
+        long        transforms  = 0;
+        auto        start       = steady_clock::now();
+        duration<double> elapsed{0};
+
+        do
+        {
+            transform_batch();
+            transforms  += nblocks;
+            elapsed     = steady_clock::now() - start;
+        } while (elapsed.count() < 0.2);
+
+        return elapsed.count() / static_cast<double>(transforms) * 1e9;
+    };
+
+    double fixed_ns = time_per_transform([&] {
+        for (int b = 0; b < nblocks; ++b)
+            fixed_out[b] = fft(fixed_in[b]);
+    });
+
+    double runtime_ns = time_per_transform([&] {
+        for (int b = 0; b < nblocks; ++b)
+            copy(fixed_in[b].begin(), fixed_in[b].end(), runtime_data.begin() + static_cast<ptrdiff_t>(b) * size);
+        execute_batch(plan, runtime_data.data(), nblocks, work);
+    });
+
+    int const default_precision = static_cast<int>(std::cout.precision());
+    cout << setw(6) << size
+            << setw(13) << setprecision(1) << fixed << fixed_ns
+            << setw(13) << setprecision(1) << fixed << runtime_ns
+            << setw(10) << setprecision(1) << fixed << runtime_ns / fixed_ns
+            << setw(14) << setprecision(2) << scientific << fixed_error
+            << setw(14) << setprecision(2) << scientific << runtime_error
+            << endl;
+    cout << setprecision(default_precision) << std::defaultfloat;
+
+    // keep the results of the timed loops alive
+    if (fixed_out[0][0] != fixed_result[0])
+        throw logic_error("fixed-size transform is not deterministic");
+}
+
+// function that compares the fixed-size transforms with the runtime plans
+template <typename complex_t>
+void test_fixed_size(string const& text, SetupInfo const& setup_info) {
+
+    cout << text << endl;
+    cout << "  size  fixed (ns)  runtime (ns)  speedup   fixed error runtime error" << endl;
+
+    test_fixed_size_instance<complex_t, 8>(setup_info);
+    test_fixed_size_instance<complex_t, 16>(setup_info);
+    test_fixed_size_instance<complex_t, 32>(setup_info);
+    test_fixed_size_instance<complex_t, 64>(setup_info);
+    test_fixed_size_instance<complex_t, 12>(setup_info);
+    test_fixed_size_instance<complex_t, 60>(setup_info);
+
+    cout << endl;
+}
+
+int main(int argc, char ** argv){
+    
+    constexpr char const* const options = "a:G:g:hHnPp:R:r:S:sT:t:";
+    constexpr char const* const usage = " [options]\n" \
+        " -a n         Choose algorithm: 1 = iterative, 2 = recursive, 3 = FFTW, 4 = four-step parallel,\n" \
+        "              5 = recursive work-stealing, 6 = recursive OpenMP static, 7 = split-radix (powers of 2),\n" \
+        "              8 = iterative with a shared twiddle table (3)\n" \
+        " -g n         Choose algorithm for radix generation: 1 = factors, 2 = factors reversed, 3 = thresholded (1)\n" \
+        " -r n         Threshold for radix generation (not used)\n" \
+        " -t n         Choose test: 1 = performance, 2 = accuracy, 3 = scaling of parallel algorithms (4, 5, 6), 4 = distributed,\n" \
+        "              5 = concurrent plan cache lookups, 6 = fixed-size transforms, 7 = pruned transforms,\n" \
+        "              8 = DCT and DST accuracy, 9 = sliding DFT, 10 = fast sizes and chirp-z, 11 = fused spectral operations,\n" \
+        "              12 = accuracy suite of all engines, radix options and precisions, 13 = asynchronous execution,\n" \
+        "              14 = planning rate of random lengths, 15 = profile of time, memory, cache footprint and energy as CSV (1)\n" \
+        " -T n         Number of threads of parallel algorithms (number of cpus)\n" \
+        " -P           Pin threads to the cpus of the NUMA nodes\n" \
+        " -G n         Grain size of the work-stealing recursion (1024)\n" \
+        " -R n         Number of processes of distributed algorithms (4)\n" \
+        " -S n         Largest size of the accuracy suite (16384)\n" \
+        " -n           Use non-powers-of-2\n" \
+        " -s           Use single precision\n" \
+        " -H           Back large buffers by huge pages\n" \
+        " -p text      Print text before the test\n" \
+        " -h           Show this help\n" \
+        "\n";
+    
+    using std::fixed;
+    using std::chrono::high_resolution_clock;
+    using std::chrono::duration_cast;
+    using std::chrono::duration;
+    using std::chrono::milliseconds;
+
+    try 
+    {
+        int     algo                    = 3;
+        int     algo_radix              = SetupInfo::not_used;
+        int     radix_threshold         = SetupInfo::not_used;
+        int     test_type               = 1;
+        bool    use_powers_of_two       = true;
+        bool    use_single_precision    = false;
+        int     nthreads                = max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        bool    pin_threads             = false;
+        int     nranks                  = 4;
+        int     grain_size              = 1024;
+        int     suite_max_size          = 16384;
+        string  preamble                = "";
+        int     c;
+
+        while((c = getopt(argc, argv, options)) != -1)
+        {
+            switch(c)
+            {
+            case 'a' :
+                algo = stoi(optarg);
+                break;
+            case 'g' :
+                algo_radix = stoi(optarg);
+                break;
+            case 'r' :
+                radix_threshold = stoi(optarg);
+                break;
+            case 't' :
+                test_type = stoi(optarg);
+                break;
+            case 'n' :
+                use_powers_of_two = false;
+                break;
+            case 's' :
+                use_single_precision = true;
+                break;
+            case 'H' :
+                use_huge_pages() = true;
+                break;
+            case 'T' :
+                nthreads = stoi(optarg);
+                break;
+            case 'P' :
+                pin_threads = true;
+                break;
+            case 'R' :
+                nranks = stoi(optarg);
+                break;
+            case 'G' :
+                grain_size = stoi(optarg);
+                break;
+            case 'S' :
+                suite_max_size = stoi(optarg);
+                break;
+            case 'p' :
+                preamble = string(optarg);
+                break;
+            case 'h' :
+                cout << "usage: " << argv[0] << usage;
+                return 0;
+            case '?' :
+            default :
+                cerr << "unknown option [" << c << "]\n";
+                cerr << "usage: " << argv[0] << usage;
+                return -1;
+            }
+        }
+        if (algo < 1 or algo > 8 or (algo_radix != SetupInfo::not_used and (algo_radix < 1 or algo_radix > 3)) or test_type < 1 or test_type > 15 or nthreads < 1 or nranks < 1 or grain_size < 1 or suite_max_size < 1)
+        {
+            cerr << algo << " " << algo_radix << " " << test_type << endl;
+            cerr << "usage: " << argv[0] << usage;
+            return -2;
+        }
+        
+        if ((algo != 3 or test_type >= 3) and algo_radix == SetupInfo::not_used)
+        {
+            cerr << "for algorithm " << algo << " a radix generation algorithm must be specified" << endl;
+            cerr << "usage: " << argv[0] << usage;
+            return -3;
+        }
+
+        Algorithm a;
+        switch (algo)
+        {
+        case 1:
+            a = iterative_breadth_first;
+            break;
+        case 2:
+            a = recursive_depth_first;
+            break;
+        case 3:
+            a = fftw_lib;
+            break;
+        case 4:
+            a = four_step_parallel;
+            break;
+        case 5:
+            a = recursive_work_stealing;
+            break;
+        case 6:
+            a = recursive_omp_static;
+            break;
+        case 7:
+            a = split_radix;
+            break;
+        case 8:
+            a = iterative_shared_twiddles;
+            break;
+        }
+
+        if (a == split_radix and not use_powers_of_two and test_type == 1)
+        {
+            cerr << "the split-radix algorithm requires powers of 2" << endl;
+            cerr << "usage: " << argv[0] << usage;
+            return -3;
+        }
+
+        if (test_type == 3 and not (a == four_step_parallel or a == recursive_work_stealing or a == recursive_omp_static))
+        {
+            cerr << "the scaling test requires a parallel algorithm (4, 5 or 6)" << endl;
+            cerr << "usage: " << argv[0] << usage;
+            return -3;
+        }
+
+        SetupInfo setup_info{algo_radix, radix_threshold, nthreads, pin_threads, nranks, grain_size};
+
+        if (test_type == 1) {
+
+            if (use_single_precision)
+                test_speed<complex<float>>(preamble, a, setup_info, use_powers_of_two);
+            else
+                test_speed<complex<double>>(preamble, a, setup_info, use_powers_of_two);
+
+        } else if (test_type == 2)
+        {
+
+            if (use_single_precision)
+                test_accuracy<complex<float>>(preamble, a, setup_info);
+            else
+                test_accuracy<complex<double>>(preamble, a, setup_info);
+
+        } else if (test_type == 3)
+        {
+
+            if (use_single_precision)
+                test_scaling<complex<float>>(preamble, a, setup_info, use_powers_of_two);
+            else
+                test_scaling<complex<double>>(preamble, a, setup_info, use_powers_of_two);
+
+        } else if (test_type == 4)
+        {
+
+            if (use_single_precision)
+                test_distributed<complex<float>>(preamble, setup_info, use_powers_of_two);
+            else
+                test_distributed<complex<double>>(preamble, setup_info, use_powers_of_two);
+
+        } else if (test_type == 5)
+        {
+
+            if (use_single_precision)
+                test_plan_cache<complex<float>>(preamble, setup_info);
+            else
+                test_plan_cache<complex<double>>(preamble, setup_info);
+
+        } else if (test_type == 6)
+        {
+
+            if (use_single_precision)
+                test_fixed_size<complex<float>>(preamble, setup_info);
+            else
+                test_fixed_size<complex<double>>(preamble, setup_info);
+
+        } else if (test_type == 7)
+        {
+
+            if (use_single_precision)
+                test_pruned<complex<float>>(preamble, setup_info, use_powers_of_two);
+            else
+                test_pruned<complex<double>>(preamble, setup_info, use_powers_of_two);
+
+        } else if (test_type == 8)
+        {
+
+            if (use_single_precision)
+                test_trig<complex<float>>(preamble, setup_info);
+            else
+                test_trig<complex<double>>(preamble, setup_info);
+
+        } else if (test_type == 9)
+        {
+
+            if (use_single_precision)
+                test_sliding<complex<float>>(preamble, setup_info, use_powers_of_two);
+            else
+                test_sliding<complex<double>>(preamble, setup_info, use_powers_of_two);
+
+        } else if (test_type == 10)
+        {
+
+            if (use_single_precision)
+                test_sizes<complex<float>>(preamble, setup_info);
+            else
+                test_sizes<complex<double>>(preamble, setup_info);
+
+        } else if (test_type == 11)
+        {
+
+            if (use_single_precision)
+                test_spectral<complex<float>>(preamble, setup_info, use_powers_of_two);
+            else
+                test_spectral<complex<double>>(preamble, setup_info, use_powers_of_two);
+
+        } else if (test_type == 12)
+        {
+
+            test_accuracy_suite(preamble, setup_info, suite_max_size);
+
+        } else if (test_type == 13)
+        {
+
+            if (use_single_precision)
+                test_async<complex<float>>(preamble, setup_info, use_powers_of_two);
+            else
+                test_async<complex<double>>(preamble, setup_info, use_powers_of_two);
+
+        } else if (test_type == 14)
+        {
+
+            if (use_single_precision)
+                test_planning<complex<float>>(preamble, setup_info);
+            else
+                test_planning<complex<double>>(preamble, setup_info);
+
+        } else
+        {
+
+            if (use_single_precision)
+                test_profile<complex<float>>(preamble, setup_info, use_powers_of_two);
+            else
+                test_profile<complex<double>>(preamble, setup_info, use_powers_of_two);
 
         }
 
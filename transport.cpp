@@ -0,0 +1,198 @@
+#include <new>
+#include <cassert>
+#include <csignal>
+#include <cstring>
+#include <cerrno>
+#include <cstdlib>
+#include <stdexcept>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/prctl.h>
+#include <unistd.h>
+
+#include "transport.hpp"
+
+SharedMemoryTransport::SharedMemoryTransport(int ranks, size_t block_capacity, int channels)
+    : nranks{ranks}, my_rank{0}, capacity{block_capacity}, nchannels{channels}, next_request{0}
+{
+    assert( nranks > 0 and nchannels > 0 );
+
+    // the state shared by the processes must not depend on locks of a single process
+    static_assert(std::atomic<int>::is_always_lock_free, "process-shared atomics must be lock-free");
+
+    // the shared state is placed in front of the mailboxes, padded to keep them cache-line aligned
+    size_t header_bytes = (sizeof(SharedState) + 63) / 64 * 64;
+
+    mapping_bytes = header_bytes + static_cast<size_t>(nchannels) * nranks * nranks * capacity;
+
+    void* mapping = mmap(nullptr, mapping_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    if (mapping == MAP_FAILED)
+        throw std::bad_alloc();
+
+    shared      = new (mapping) SharedState{{0}, {0}, {0}};
+    mailboxes   = static_cast<char*>(mapping) + header_bytes;
+}
+
+SharedMemoryTransport::~SharedMemoryTransport()
+{
+    // every process unmaps its own view
+    munmap(shared, mapping_bytes);
+}
+
+char* SharedMemoryTransport::mailbox(int channel, int destination, int source) const
+{
+    return mailboxes + ((static_cast<size_t>(channel) * nranks + destination) * nranks + source) * capacity;
+}
+
+int SharedMemoryTransport::start_alltoall(void const* send, void* recv, size_t block_bytes)
+{
+    if (block_bytes > capacity)
+        throw std::length_error("block exceeds the mailbox capacity of the shared memory transport");
+
+    assert( static_cast<int>(pending.size()) < nchannels );
+
+    int channel = next_request % nchannels;
+
+    // post the blocks right away, they are picked up by the receivers in wait
+    for (int destination = 0; destination < nranks; ++destination)
+        std::memcpy(mailbox(channel, destination, my_rank), static_cast<char const*>(send) + destination * block_bytes, block_bytes);
+
+    pending.push_back(Request{channel, recv, block_bytes});
+
+    return next_request++;
+}
+
+void SharedMemoryTransport::wait(int request)
+{
+    assert( not pending.empty() and request == next_request - static_cast<int>(pending.size()) );
+
+    Request r = pending.front();
+    pending.erase(pending.begin());
+
+    // all blocks of the channel are posted once every rank has arrived
+    barrier();
+
+    for (int source = 0; source < nranks; ++source)
+        std::memcpy(static_cast<char*>(r.recv) + source * r.block_bytes, mailbox(r.channel, my_rank, source), r.block_bytes);
+
+    // the channel may only be reused after every rank has read its blocks
+    barrier();
+}
+
+bool SharedMemoryTransport::child_exited() const
+{
+    for (pid_t pid : children)
+    {
+        siginfo_t info{};
+
+        // WNOWAIT leaves the child to be reaped by run
+        if (waitid(P_PID, static_cast<id_t>(pid), &info, WEXITED | WNOHANG | WNOWAIT) == 0 and info.si_pid != 0)
+            return true;
+    }
+
+    return false;
+}
+
+void SharedMemoryTransport::barrier()
+{
+    if (shared->failed)
+        throw TransportAborted();
+
+    int generation = shared->generation;
+
+    if (shared->arrived.fetch_add(1) + 1 == nranks)
+    {
+        shared->arrived = 0;
+        ++shared->generation;
+        return;
+    }
+
+    // ranks may be more than cpus, so the waiting ranks yield, rank 0 also notices ranks that have ended
+    while (shared->generation == generation)
+    {
+        // a rank that has ended after passing this barrier has incremented the generation before
+        if (shared->failed or (my_rank == 0 and child_exited() and shared->generation == generation))
+        {
+            shared->failed = 1;
+            throw TransportAborted();
+        }
+
+        sched_yield();
+    }
+}
+
+bool SharedMemoryTransport::run(int ranks, size_t block_capacity, int channels, std::function<bool(Transport&)> const& body)
+{
+    SharedMemoryTransport transport(ranks, block_capacity, channels);
+
+    pid_t const parent = getpid();
+
+    // a failed rank sets the flag, so that the others leave their collective operations
+    auto run_body = [&]() {
+        bool success = false;
+        try
+        {
+            success = body(transport);
+        }
+        catch (...)
+        {
+        }
+        if (not success)
+            transport.shared->failed = 1;
+        return success;
+    };
+
+    bool success = true;
+
+    for (int r = 1; r < ranks and success; ++r)
+    {
+        pid_t pid = fork();
+
+        if (pid < 0)
+        {
+            transport.shared->failed = 1;
+            success = false;
+            break;
+        }
+
+        if (pid == 0)
+        {
+            // the ranks must not outlive rank 0, which could no longer notice that they hang
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+            if (getppid() != parent)
+                _exit(EXIT_FAILURE);
+
+            transport.my_rank = r;
+            transport.children.clear();
+
+            bool child_success = run_body();
+
+            // skip the destructors and atexit handlers of the parent's state
+            _exit(child_success ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+
+        transport.children.push_back(pid);
+    }
+
+    if (success)
+        success = run_body();
+
+    // ranks still running after a failure may be stuck outside of the collective operations
+    if (transport.shared->failed)
+        for (pid_t pid : transport.children)
+            kill(pid, SIGKILL);
+
+    for (pid_t pid : transport.children)
+    {
+        int status = 0;
+
+        while (waitpid(pid, &status, 0) < 0 and errno == EINTR)
+            ;
+
+        success = success and WIFEXITED(status) and WEXITSTATUS(status) == EXIT_SUCCESS;
+    }
+
+    return success;
+}
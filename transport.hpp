@@ -0,0 +1,155 @@
+#ifndef TRANSPORT_H_
+#define TRANSPORT_H_
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <sys/types.h>
+
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
+// communication layer of the distributed transforms, all operations are collective
+class Transport
+{
+public:
+    virtual ~Transport() = default;
+
+    virtual int rank() const = 0;
+    virtual int size() const = 0;
+
+    // Start an all-to-all exchange: block s of send (block_bytes each) goes to rank s,
+    // block r of recv is received from rank r. Both buffers must stay valid until the
+    // returned request has been completed by wait, which every rank calls in the same order.
+    virtual int start_alltoall(void const* send, void* recv, size_t block_bytes) = 0;
+    virtual void wait(int request) = 0;
+
+    virtual void barrier() = 0;
+
+    void alltoall(void const* send, void* recv, size_t block_bytes)
+    {
+        wait(start_alltoall(send, recv, block_bytes));
+    };
+};
+
+// thrown by the collective operations of a rank when another rank has failed
+class TransportAborted : public std::runtime_error
+{
+public:
+    TransportAborted() : std::runtime_error("another rank of the transport has failed") {};
+};
+
+// Stand-in for a cluster on a single machine: the ranks are forked processes that
+// exchange data through mailboxes in an anonymous shared mapping. Each outstanding
+// exchange uses one of the channels, a set of mailboxes of block_capacity bytes per block,
+// exchanges have to be completed in the order in which they were started. The blocks are
+// copied synchronously, into the mailboxes by start_alltoall and out of them by wait, so
+// unlike MpiTransport this transport does not overlap communication with computation.
+// If a rank fails (its body throws, returns false or the process ends early), the other
+// ranks leave their collective operations with TransportAborted instead of waiting forever.
+class SharedMemoryTransport : public Transport
+{
+public:
+    SharedMemoryTransport(int ranks, size_t block_capacity, int channels);
+    ~SharedMemoryTransport() override;
+
+    SharedMemoryTransport(SharedMemoryTransport const&) = delete;
+    SharedMemoryTransport& operator=(SharedMemoryTransport const&) = delete;
+
+    int rank() const override { return my_rank; };
+    int size() const override { return nranks; };
+
+    int start_alltoall(void const* send, void* recv, size_t block_bytes) override;
+    void wait(int request) override;
+    void barrier() override;
+
+    // run body on ranks processes (rank 0 is the calling process), returns true if all succeeded,
+    // all other processes have been reaped when it returns
+    static bool run(int ranks, size_t block_capacity, int channels, std::function<bool(Transport&)> const& body);
+
+private:
+    struct Request
+    {
+        int     channel;
+        void*   recv;
+        size_t  block_bytes;
+    };
+
+    // sense-reversing barrier and failure flag at the start of the shared mapping
+    struct SharedState
+    {
+        std::atomic<int>    arrived;
+        std::atomic<int>    generation;
+        std::atomic<int>    failed;
+    };
+
+    int                     nranks;
+    int                     my_rank;
+    size_t                  capacity;
+    int                     nchannels;
+    int                     next_request;
+    size_t                  mapping_bytes;
+    SharedState*            shared;
+    char*                   mailboxes;
+    std::vector<Request>    pending;
+    std::vector<pid_t>      children;       // the other ranks, known to rank 0 only
+
+    char* mailbox(int channel, int destination, int source) const;
+
+    // true if one of the other ranks has ended, it is not reaped
+    bool child_exited() const;
+};
+
+#ifdef USE_MPI
+// production transport, every MPI process is one rank of the communicator
+class MpiTransport : public Transport
+{
+public:
+    explicit MpiTransport(MPI_Comm comm = MPI_COMM_WORLD) : comm{comm} {};
+
+    int rank() const override
+    {
+        int r;
+        MPI_Comm_rank(comm, &r);
+        return r;
+    };
+
+    int size() const override
+    {
+        int s;
+        MPI_Comm_size(comm, &s);
+        return s;
+    };
+
+    int start_alltoall(void const* send, void* recv, size_t block_bytes) override
+    {
+        requests.emplace_back();
+        MPI_Ialltoall(send, static_cast<int>(block_bytes), MPI_BYTE, recv, static_cast<int>(block_bytes), MPI_BYTE, comm, &requests.back());
+        return static_cast<int>(requests.size()) - 1;
+    };
+
+    void wait(int request) override
+    {
+        MPI_Wait(&requests[request], MPI_STATUS_IGNORE);
+
+        // completed requests are reset to MPI_REQUEST_NULL, the ids restart once all are done
+        if (std::all_of(requests.begin(), requests.end(), [](MPI_Request const& r){ return r == MPI_REQUEST_NULL; }))
+            requests.clear();
+    };
+
+    void barrier() override
+    {
+        MPI_Barrier(comm);
+    };
+
+private:
+    MPI_Comm                    comm;
+    std::vector<MPI_Request>    requests;
+};
+#endif
+
+#endif
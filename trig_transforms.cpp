@@ -0,0 +1,79 @@
+#include <cassert>
+
+#include "trig_transforms.hpp"
+
+TrigPlan make_trig_plan(TrigKind kind, int size, int option, int threshold)
+{
+    assert( size > 0 );
+    assert( kind != TrigKind::dct1 or size > 1 );
+
+    TrigPlan plan{kind, size, {}, {}, {}, {}};
+
+    auto phase = [](long double angle) { return static_cast<std::complex<double>>(std::polar(1.0L, angle)); };
+
+    switch (kind)
+    {
+    case TrigKind::dct1:
+        plan.real_plan = make_real_plan(2 * size - 2, option, threshold);
+        break;
+    case TrigKind::dst1:
+        plan.real_plan = make_real_plan(2 * size + 2, option, threshold);
+        break;
+    case TrigKind::dct2:
+    case TrigKind::dst2:
+    case TrigKind::dct3:
+    case TrigKind::dst3:
+        plan.real_plan = make_real_plan(size, option, threshold);
+        for (int k = 0; k < size; ++k)
+            plan.post_twiddles.push_back(phase(-PI * k / (2 * size)));
+        break;
+    case TrigKind::dct4:
+    case TrigKind::dst4:
+        if (size % 2 == 0)
+        {
+            plan.complex_plan = make_plan(size / 2, option, threshold);
+            for (int m = 0; m < size / 2; ++m)
+            {
+                plan.pre_twiddles.push_back(phase(-PI * (4 * m + 1) / (4 * size)));
+                plan.post_twiddles.push_back(phase(-PI * m / size));
+            }
+        }
+        else
+        {
+            plan.complex_plan = make_plan(2 * size, option, threshold);
+            for (int n = 0; n < size; ++n)
+            {
+                plan.pre_twiddles.push_back(phase(-PI * n / (2 * size)));
+                plan.post_twiddles.push_back(phase(-PI * (2 * n + 1) / (4 * size)));
+            }
+        }
+        break;
+    }
+
+    return plan;
+}
+
+char const* trig_kind_name(TrigKind kind)
+{
+    switch (kind)
+    {
+    case TrigKind::dct1:
+        return "DCT-I";
+    case TrigKind::dct2:
+        return "DCT-II";
+    case TrigKind::dct3:
+        return "DCT-III";
+    case TrigKind::dct4:
+        return "DCT-IV";
+    case TrigKind::dst1:
+        return "DST-I";
+    case TrigKind::dst2:
+        return "DST-II";
+    case TrigKind::dst3:
+        return "DST-III";
+    case TrigKind::dst4:
+        return "DST-IV";
+    }
+
+    return "";
+}
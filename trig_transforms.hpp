@@ -0,0 +1,221 @@
+#ifndef TRIG_TRANSFORMS_H_
+#define TRIG_TRANSFORMS_H_
+
+#include <cmath>
+#include <vector>
+#include <complex>
+#include <cassert>
+
+#include "ffts.hpp"
+#include "real_ffts.hpp"
+
+// real-even (DCT) and real-odd (DST) transforms of types I to IV,
+// unnormalized with the definitions of FFTW (REDFT00 ... RODFT11):
+//     DCT-I    y[k] = x[0] + (-1)^k x[N-1] + 2 sum_{n=1}^{N-2} x[n] cos(pi n k / (N - 1))
+//     DCT-II   y[k] = 2 sum_n x[n] cos(pi (n + 1/2) k / N)
+//     DCT-III  y[k] = x[0] + 2 sum_{n=1}^{N-1} x[n] cos(pi n (k + 1/2) / N)
+//     DCT-IV   y[k] = 2 sum_n x[n] cos(pi (n + 1/2) (k + 1/2) / N)
+//     DST-I    y[k] = 2 sum_n x[n] sin(pi (n + 1) (k + 1) / (N + 1))
+//     DST-II   y[k] = 2 sum_n x[n] sin(pi (n + 1/2) (k + 1) / N)
+//     DST-III  y[k] = (-1)^k x[N-1] + 2 sum_{n=0}^{N-2} x[n] sin(pi (n + 1) (k + 1/2) / N)
+//     DST-IV   y[k] = 2 sum_n x[n] sin(pi (n + 1/2) (k + 1/2) / N)
+// Type III is the inverse of type II and types I and IV are their own inverses, up to a factor
+// 2 (N - 1), 2 N, 2 (N + 1) and 2 N respectively.
+enum class TrigKind {dct1, dct2, dct3, dct4, dst1, dst2, dst3, dst4};
+
+// Setup of a transform of size real values:
+//     types I     real transform of the even (odd) extension of size 2 N - 2 (2 N + 2),
+//     types II    real transform of size N of x[0], x[2], ..., x[3], x[1] (Makhoul), post-twiddle exp(-i pi k / 2N),
+//     types III   the inverse steps of type II,
+//     types IV    complex transform of size N / 2 of x[2m] + i x[N-1-2m] with pre- and post-twiddles,
+//                 for odd N a zero-padded complex transform of size 2 N.
+// The DSTs are DCTs of the input with alternating signs or in reverse order.
+struct TrigPlan
+{
+    TrigKind                            kind;
+    int                                 size;
+    RealFftPlan                         real_plan;
+    FftPlan                             complex_plan;
+    std::vector<std::complex<double>>   pre_twiddles;
+    std::vector<std::complex<double>>   post_twiddles;
+};
+
+TrigPlan make_trig_plan(TrigKind kind, int size, int option, int threshold);
+
+char const* trig_kind_name(TrigKind kind);
+
+// transform in[0, size) into out[0, size), in and out may be the same array,
+// the work vector is resized if necessary
+template <typename real_t>
+void execute_trig(TrigPlan const& plan, real_t const* in, real_t* out, FftBuffer<std::complex<real_t>>& work)
+{
+    using complex_t = std::complex<real_t>;
+
+    int     size    = plan.size;
+    bool    sine    = plan.kind == TrigKind::dst1 or plan.kind == TrigKind::dst2 or plan.kind == TrigKind::dst3 or plan.kind == TrigKind::dst4;
+
+    auto pre    = [&](int k) { return static_cast<complex_t>(plan.pre_twiddles[k]); };
+    auto post   = [&](int k) { return static_cast<complex_t>(plan.post_twiddles[k]); };
+
+    // position of element n of the sequence reordered for types II and III
+    auto makhoul = [size](int n) { return n < (size + 1) / 2 ? 2 * n : 2 * (size - 1 - n) + 1; };
+
+    switch (plan.kind)
+    {
+    case TrigKind::dct1:
+    {
+        int extended = 2 * size - 2;
+
+        fft_r2c_fused<real_t>(plan.real_plan,
+                [&](int j) { return j < size ? in[j] : in[extended - j]; },
+                [&](int k, complex_t const& x) { out[k] = x.real(); },
+                work);
+        break;
+    }
+    case TrigKind::dst1:
+    {
+        int extended = 2 * size + 2;
+
+        fft_r2c_fused<real_t>(plan.real_plan,
+                [&](int j) { return j == 0 or j == size + 1 ? real_t(0.0) : (j <= size ? in[j - 1] : -in[extended - j - 1]); },
+                [&](int k, complex_t const& x) { if (k >= 1 and k <= size) out[k - 1] = -x.imag(); },
+                work);
+        break;
+    }
+    case TrigKind::dct2:
+    case TrigKind::dst2:
+    {
+        // DST-II(x)[k] = DCT-II((-1)^n x[n])[N - 1 - k]
+        fft_r2c_fused<real_t>(plan.real_plan,
+                [&](int n) {
+                    int j = makhoul(n);
+                    return sine and j % 2 != 0 ? -in[j] : in[j];
+                },
+                [&](int k, complex_t const& v) {
+                    // y[k] = 2 Re(w_k V[k]) and y[N - k] = -2 Im(w_k V[k])
+                    complex_t u = post(k) * v;
+                    out[sine ? size - 1 - k : k] = 2 * u.real();
+                    if (k > 0 and size - k != k)
+                        out[sine ? k - 1 : size - k] = -2 * u.imag();
+                },
+                work);
+        break;
+    }
+    case TrigKind::dct3:
+    case TrigKind::dst3:
+    {
+        // DST-III(x)[k] = (-1)^k DCT-III(x[N - 1 - n])[k]
+        auto x = [&](int j) { return j >= size ? real_t(0.0) : (sine ? in[size - 1 - j] : in[j]); };
+
+        fft_c2r_fused<real_t>(plan.real_plan,
+                [&](int k) { return std::conj(post(k)) * complex_t(x(k), -x(size - k)); },
+                [&](int n, real_t v) {
+                    int j = makhoul(n);
+                    out[j] = sine and j % 2 != 0 ? -v : v;
+                },
+                work);
+        break;
+    }
+    case TrigKind::dct4:
+    case TrigKind::dst4:
+    {
+        // DST-IV(x)[k] = (-1)^k DCT-IV(x[N - 1 - n])[k]
+        auto x = [&](int j) { return sine ? in[size - 1 - j] : in[j]; };
+
+        if (size % 2 == 0)
+        {
+
+            int half = size / 2;
+
+            work.resize(half);
+            for (int m = 0; m < half; ++m)
+                work[m] = complex_t(x(2 * m), x(size - 1 - 2 * m)) * pre(m);
+
+            fft_iterative_breadth_first(work, plan.complex_plan.radices);
+
+            // y[2m] = 2 Re(u_m) and y[N - 1 - 2m] = -2 Im(u_m)
+            for (int m = 0; m < half; ++m)
+            {
+                complex_t u = work[m] * post(m);
+                out[2 * m]              = 2 * u.real();
+                out[size - 1 - 2 * m]   = sine ? 2 * u.imag() : -2 * u.imag();
+            }
+
+        }
+        else
+        {
+
+            work.assign(2 * size, 0.0);
+            for (int n = 0; n < size; ++n)
+                work[n] = x(n) * pre(n);
+
+            fft_iterative_breadth_first(work, plan.complex_plan.radices);
+
+            for (int k = 0; k < size; ++k)
+            {
+                real_t y = 2 * (post(k) * work[k]).real();
+                out[k] = sine and k % 2 != 0 ? -y : y;
+            }
+
+        }
+        break;
+    }
+    }
+}
+
+// transform by the direct formulas in O(n^2) runtime complexity
+template <typename real_t>
+std::vector<real_t> trig_matrix_mult(TrigKind kind, std::vector<real_t> const& in)
+{
+    int size = static_cast<int>(in.size());
+
+    std::vector<real_t> out(size, 0.0);
+
+    for (int k = 0; k < size; ++k)
+    {
+
+        long double y = 0.0;
+
+        for (int n = 0; n < size; ++n)
+        {
+
+            long double x = in[n];
+
+            switch (kind)
+            {
+            case TrigKind::dct1:
+                y += (n == 0 or n == size - 1 ? 1 : 2) * x * std::cos(PI * n * k / (size - 1));
+                break;
+            case TrigKind::dct2:
+                y += 2 * x * std::cos(PI * (n + 0.5L) * k / size);
+                break;
+            case TrigKind::dct3:
+                y += (n == 0 ? 1 : 2) * x * std::cos(PI * n * (k + 0.5L) / size);
+                break;
+            case TrigKind::dct4:
+                y += 2 * x * std::cos(PI * (n + 0.5L) * (k + 0.5L) / size);
+                break;
+            case TrigKind::dst1:
+                y += 2 * x * std::sin(PI * (n + 1) * (k + 1) / (size + 1));
+                break;
+            case TrigKind::dst2:
+                y += 2 * x * std::sin(PI * (n + 0.5L) * (k + 1) / size);
+                break;
+            case TrigKind::dst3:
+                y += (n == size - 1 ? 1 : 2) * x * std::sin(PI * (n + 1) * (k + 0.5L) / size);
+                break;
+            case TrigKind::dst4:
+                y += 2 * x * std::sin(PI * (n + 0.5L) * (k + 0.5L) / size);
+                break;
+            }
+
+        }
+
+        out[k] = static_cast<real_t>(y);
+
+    }
+
+    return out;
+}
+
+#endif
@@ -1,11 +1,12 @@
 #include <vector>
 #include <cmath>
 #include <complex>
+#include <cassert>
 
 // adapted from: 17-cholesky/matrix.hpp by Thorsten Koch
 
-template <typename T>
-T max_norm(std::vector<std::complex<T>> const& vec)
+template <typename T, typename Alloc>
+T max_norm(std::vector<std::complex<T>, Alloc> const& vec)
 {
     T max_x = 0.0;
     T abs_x;
@@ -19,8 +20,8 @@ T max_norm(std::vector<std::complex<T>> const& vec)
     return max_x;
 }
 
-template <typename T>
-T two_norm(std::vector<std::complex<T>> const& vec)
+template <typename T, typename Alloc>
+T two_norm(std::vector<std::complex<T>, Alloc> const& vec)
 {
    T sum = 0.0;
    
@@ -30,12 +31,12 @@ T two_norm(std::vector<std::complex<T>> const& vec)
    return std::sqrt(sum);
 }
 
-template <typename T>
-std::vector<T> operator-(std::vector<T> const& a, std::vector<T> const& b)
+template <typename T, typename Alloc>
+std::vector<T, Alloc> operator-(std::vector<T, Alloc> const& a, std::vector<T, Alloc> const& b)
 {
    assert(a.size() == b.size());
 
-   std::vector<T> r(a.size(), 0.0);
+   std::vector<T, Alloc> r(a.size(), 0.0);
    
    for(size_t i = 0; i < a.size(); ++i)
       r[i] = a[i] - b[i];